@@ -0,0 +1,968 @@
+#include "attendee_set.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <assert.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define ATTENDEE_SET_USE_SSE2
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define ATTENDEE_SET_USE_NEON
+#endif
+
+#define MIN_SET_CAPACITY 1
+#define MIN_ARRAY_CAPACITY 4
+#define EXPAND_FACTOR 2
+#define CONTAINER_BITS 16
+#define LOW_MASK 0xFFFF
+#define WORD_BITS 64
+#define BITMAP_WORDS 1024
+#define ARRAY_MAX_SIZE 4096
+#define ARRAY_MIN_SIZE 2048
+#define SIMD_LANES 8
+
+/**
+* Holds the ids of the set that share their high CONTAINER_BITS bits, key, by their low bits.
+* words is NULL for an array container, which keeps size low bits in ascending order in values,
+* allocated for capacity of them. Otherwise it is a bitmap container of BITMAP_WORDS words,
+* where low bit i is set if the id is in the set, and values is NULL.
+* An array container becomes a bitmap once it would hold more than ARRAY_MAX_SIZE values, where
+* both take the same memory, and a bitmap goes back to an array once it holds ARRAY_MIN_SIZE
+* values or less, so that adding and removing around the limit does not convert it each time.
+* A container is never empty.
+*/
+typedef struct Container_t
+{
+    uint16_t key;
+    int size;
+    int capacity;
+    uint16_t *values;
+    uint64_t *words;
+} Container;
+
+/**
+* Struct representing an attendee set, in the layout of a roaring bitmap.
+* containers holds count containers in ascending key order, allocated for capacity of them,
+* and size is the number of ids in all of them.
+*/
+struct AttendeeSet_t
+{
+    int size;
+    int count;
+    int capacity;
+    Container *containers;
+};
+
+typedef enum BitmapOperation_t
+{
+    BITMAP_AND,
+    BITMAP_OR,
+    BITMAP_AND_NOT
+} BitmapOperation;
+
+static int popcount64(uint64_t word)
+{
+#if defined(__GNUC__)
+    return __builtin_popcountll(word);
+#else
+    word = word - ((word >> 1) & 0x5555555555555555ULL);
+    word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+    word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (int)((word * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+static int lowestBit(uint64_t word)
+{
+    assert(word != 0);
+#if defined(__GNUC__)
+    return __builtin_ctzll(word);
+#else
+    int bit = 0;
+    while (!((word >> bit) & 1))
+    {
+        bit++;
+    }
+    return bit;
+#endif
+}
+
+static uint64_t combineWords(uint64_t a, uint64_t b, BitmapOperation operation)
+{
+    return operation == BITMAP_AND ? a & b : operation == BITMAP_OR ? a | b : a & ~b;
+}
+
+/**
+* Combines two bitmaps word by word and returns the number of bits set in the result.
+* The result is stored in target, which may be a, unless target is NULL.
+*/
+static int bitmapCombine(uint64_t *target, const uint64_t *a, const uint64_t *b, BitmapOperation operation)
+{
+    int count = 0;
+    int i = 0;
+#if defined(ATTENDEE_SET_USE_SSE2)
+    // SSE2 has no popcount, so the 128 bit result is counted as two words
+    for (; i < BITMAP_WORDS; i += 2)
+    {
+        __m128i x = _mm_loadu_si128((const __m128i *)(a + i));
+        __m128i y = _mm_loadu_si128((const __m128i *)(b + i));
+        __m128i result = operation == BITMAP_AND  ? _mm_and_si128(x, y)
+                         : operation == BITMAP_OR ? _mm_or_si128(x, y)
+                                                  : _mm_andnot_si128(y, x);
+        uint64_t lanes[2];
+        _mm_storeu_si128((__m128i *)lanes, result);
+        if (target != NULL)
+        {
+            target[i] = lanes[0];
+            target[i + 1] = lanes[1];
+        }
+        count += popcount64(lanes[0]) + popcount64(lanes[1]);
+    }
+#elif defined(ATTENDEE_SET_USE_NEON)
+    uint64x2_t counts = vdupq_n_u64(0);
+    for (; i < BITMAP_WORDS; i += 2)
+    {
+        uint64x2_t x = vld1q_u64(a + i);
+        uint64x2_t y = vld1q_u64(b + i);
+        uint64x2_t result = operation == BITMAP_AND  ? vandq_u64(x, y)
+                            : operation == BITMAP_OR ? vorrq_u64(x, y)
+                                                     : vbicq_u64(x, y);
+        if (target != NULL)
+        {
+            vst1q_u64(target + i, result);
+        }
+        counts = vaddq_u64(counts, vpaddlq_u32(vpaddlq_u16(vpaddlq_u8(vcntq_u8(vreinterpretq_u8_u64(result))))));
+    }
+    count = (int)(vgetq_lane_u64(counts, 0) + vgetq_lane_u64(counts, 1));
+#endif
+    for (; i < BITMAP_WORDS; i++)
+    {
+        uint64_t result = combineWords(a[i], b[i], operation);
+        if (target != NULL)
+        {
+            target[i] = result;
+        }
+        count += popcount64(result);
+    }
+    return count;
+}
+
+/**
+* Counts the values two ascending arrays have in common.
+* While the next value of b is past a block of SIMD_LANES values of a, the block is skipped
+* whole. Otherwise the value can only be in that block, which is compared with it at once.
+*/
+static int arrayIntersectionCount(const uint16_t *a, int a_size, const uint16_t *b, int b_size)
+{
+    int count = 0;
+    int i = 0;
+    int j = 0;
+#if defined(ATTENDEE_SET_USE_SSE2) || defined(ATTENDEE_SET_USE_NEON)
+    while (i + SIMD_LANES <= a_size && j < b_size)
+    {
+        if (a[i + SIMD_LANES - 1] < b[j])
+        {
+            i += SIMD_LANES;
+            continue;
+        }
+#if defined(ATTENDEE_SET_USE_SSE2)
+        __m128i block = _mm_loadu_si128((const __m128i *)(a + i));
+        count += _mm_movemask_epi8(_mm_cmpeq_epi16(block, _mm_set1_epi16((short)b[j]))) != 0;
+#else
+        uint64x2_t equal = vreinterpretq_u64_u16(vceqq_u16(vld1q_u16(a + i), vdupq_n_u16(b[j])));
+        count += (vgetq_lane_u64(equal, 0) | vgetq_lane_u64(equal, 1)) != 0;
+#endif
+        j++;
+    }
+#endif
+    while (i < a_size && j < b_size)
+    {
+        if (a[i] < b[j])
+        {
+            i++;
+        }
+        else if (a[i] > b[j])
+        {
+            j++;
+        }
+        else
+        {
+            count++;
+            i++;
+            j++;
+        }
+    }
+    return count;
+}
+
+static bool bitmapContains(const uint64_t *words, uint16_t low)
+{
+    return (words[low / WORD_BITS] >> (low % WORD_BITS)) & 1;
+}
+
+static void bitmapSet(uint64_t *words, uint16_t low)
+{
+    words[low / WORD_BITS] |= (uint64_t)1 << (low % WORD_BITS);
+}
+
+static void bitmapClear(uint64_t *words, uint16_t low)
+{
+    words[low / WORD_BITS] &= ~((uint64_t)1 << (low % WORD_BITS));
+}
+
+/** Returns the position of the first value of the array container not smaller than low */
+static int arrayLowerBound(const Container *container, int low)
+{
+    int begin = 0;
+    int end = container->size;
+    while (begin < end)
+    {
+        int middle = begin + (end - begin) / 2;
+        if (container->values[middle] < low)
+        {
+            begin = middle + 1;
+        }
+        else
+        {
+            end = middle;
+        }
+    }
+    return begin;
+}
+
+static bool containerContains(const Container *container, uint16_t low)
+{
+    if (container->words != NULL)
+    {
+        return bitmapContains(container->words, low);
+    }
+    int index = arrayLowerBound(container, low);
+    return index < container->size && container->values[index] == low;
+}
+
+/** Returns the smallest value of the container not smaller than low, -1 if there is none */
+static int containerNext(const Container *container, int low)
+{
+    if (container->words == NULL)
+    {
+        int index = arrayLowerBound(container, low);
+        return index < container->size ? container->values[index] : -1;
+    }
+    int word = low / WORD_BITS;
+    if (word >= BITMAP_WORDS)
+    {
+        return -1;
+    }
+    uint64_t bits = container->words[word] & (~(uint64_t)0 << (low % WORD_BITS));
+    while (bits == 0)
+    {
+        if (++word == BITMAP_WORDS)
+        {
+            return -1;
+        }
+        bits = container->words[word];
+    }
+    return word * WORD_BITS + lowestBit(bits);
+}
+
+static void containerFree(Container *container)
+{
+    free(container->values);
+    free(container->words);
+}
+
+static AttendeeSetResult containerToBitmap(Container *container)
+{
+    assert(container->words == NULL);
+    uint64_t *words = calloc(BITMAP_WORDS, sizeof(*words));
+    if (words == NULL)
+    {
+        return ATTENDEE_SET_OUT_OF_MEMORY;
+    }
+    for (int i = 0; i < container->size; i++)
+    {
+        bitmapSet(words, container->values[i]);
+    }
+    free(container->values);
+    container->values = NULL;
+    container->capacity = 0;
+    container->words = words;
+    return ATTENDEE_SET_SUCCESS;
+}
+
+static AttendeeSetResult containerToArray(Container *container)
+{
+    assert(container->words != NULL);
+    int capacity = container->size > MIN_ARRAY_CAPACITY ? container->size : MIN_ARRAY_CAPACITY;
+    uint16_t *values = malloc(capacity * sizeof(*values));
+    if (values == NULL)
+    {
+        return ATTENDEE_SET_OUT_OF_MEMORY;
+    }
+    int count = 0;
+    for (int word = 0; word < BITMAP_WORDS; word++)
+    {
+        for (uint64_t bits = container->words[word]; bits != 0; bits &= bits - 1)
+        {
+            values[count++] = (uint16_t)(word * WORD_BITS + lowestBit(bits));
+        }
+    }
+    assert(count == container->size);
+    free(container->words);
+    container->words = NULL;
+    container->values = values;
+    container->capacity = capacity;
+    return ATTENDEE_SET_SUCCESS;
+}
+
+/**
+* Moves a container to the representation that fits its size. Staying in the other one is
+* fine if the conversion fails, both hold the same values.
+*/
+static void containerNormalize(Container *container)
+{
+    if (container->words != NULL && container->size > 0 && container->size <= ARRAY_MIN_SIZE)
+    {
+        containerToArray(container);
+    }
+    else if (container->words == NULL && container->size > ARRAY_MAX_SIZE)
+    {
+        containerToBitmap(container);
+    }
+}
+
+static AttendeeSetResult containerCopy(Container *target, const Container *container)
+{
+    *target = *container;
+    target->values = NULL;
+    target->words = NULL;
+    if (container->words != NULL)
+    {
+        target->words = malloc(BITMAP_WORDS * sizeof(*target->words));
+        if (target->words == NULL)
+        {
+            return ATTENDEE_SET_OUT_OF_MEMORY;
+        }
+        memcpy(target->words, container->words, BITMAP_WORDS * sizeof(*target->words));
+        return ATTENDEE_SET_SUCCESS;
+    }
+    target->capacity = container->size;
+    target->values = malloc(container->size * sizeof(*target->values));
+    if (target->values == NULL)
+    {
+        return ATTENDEE_SET_OUT_OF_MEMORY;
+    }
+    memcpy(target->values, container->values, container->size * sizeof(*target->values));
+    return ATTENDEE_SET_SUCCESS;
+}
+
+static AttendeeSetResult containerAdd(Container *container, uint16_t low)
+{
+    if (container->words == NULL && container->size >= ARRAY_MAX_SIZE &&
+        !containerContains(container, low) && containerToBitmap(container) == ATTENDEE_SET_OUT_OF_MEMORY)
+    {
+        return ATTENDEE_SET_OUT_OF_MEMORY;
+    }
+    if (container->words != NULL)
+    {
+        if (bitmapContains(container->words, low))
+        {
+            return ATTENDEE_SET_ID_ALREADY_EXISTS;
+        }
+        bitmapSet(container->words, low);
+        container->size++;
+        return ATTENDEE_SET_SUCCESS;
+    }
+
+    int index = arrayLowerBound(container, low);
+    if (index < container->size && container->values[index] == low)
+    {
+        return ATTENDEE_SET_ID_ALREADY_EXISTS;
+    }
+    if (container->size == container->capacity)
+    {
+        int capacity = container->capacity < MIN_ARRAY_CAPACITY ? MIN_ARRAY_CAPACITY
+                                                                : container->capacity * EXPAND_FACTOR;
+        uint16_t *values = realloc(container->values, capacity * sizeof(*values));
+        if (values == NULL)
+        {
+            return ATTENDEE_SET_OUT_OF_MEMORY;
+        }
+        container->values = values;
+        container->capacity = capacity;
+    }
+    memmove(container->values + index + 1, container->values + index,
+            (container->size - index) * sizeof(*container->values));
+    container->values[index] = low;
+    container->size++;
+    return ATTENDEE_SET_SUCCESS;
+}
+
+static void containerRemove(Container *container, uint16_t low)
+{
+    assert(containerContains(container, low));
+    container->size--;
+    if (container->words != NULL)
+    {
+        bitmapClear(container->words, low);
+        containerNormalize(container);
+        return;
+    }
+    int index = arrayLowerBound(container, low);
+    memmove(container->values + index, container->values + index + 1,
+            (container->size - index) * sizeof(*container->values));
+}
+
+/** Returns the number of values two containers have in common */
+static int containerIntersectionCount(const Container *a, const Container *b)
+{
+    if (a->words != NULL && b->words != NULL)
+    {
+        return bitmapCombine(NULL, a->words, b->words, BITMAP_AND);
+    }
+    if (a->words == NULL && b->words == NULL)
+    {
+        // the block skipping works best when stepping through the larger array
+        return a->size >= b->size ? arrayIntersectionCount(a->values, a->size, b->values, b->size)
+                                  : arrayIntersectionCount(b->values, b->size, a->values, a->size);
+    }
+    const Container *array = a->words == NULL ? a : b;
+    const Container *bitmap = a->words == NULL ? b : a;
+    int count = 0;
+    for (int i = 0; i < array->size; i++)
+    {
+        count += bitmapContains(bitmap->words, array->values[i]);
+    }
+    return count;
+}
+
+/** Keeps the values of an array container for which other holds keep */
+static void arrayFilter(Container *container, const Container *other, bool keep)
+{
+    int count = 0;
+    for (int i = 0; i < container->size; i++)
+    {
+        if (containerContains(other, container->values[i]) == keep)
+        {
+            container->values[count++] = container->values[i];
+        }
+    }
+    container->size = count;
+}
+
+static void containerIntersect(Container *container, const Container *other)
+{
+    if (container->words == NULL)
+    {
+        arrayFilter(container, other, true);
+        return;
+    }
+    if (other->words != NULL)
+    {
+        container->size = bitmapCombine(container->words, container->words, other->words, BITMAP_AND);
+    }
+    else
+    {
+        // mask every word with the values of other that fall in it
+        int index = 0;
+        for (int word = 0; word < BITMAP_WORDS; word++)
+        {
+            uint64_t mask = 0;
+            for (; index < other->size && other->values[index] / WORD_BITS == word; index++)
+            {
+                mask |= (uint64_t)1 << (other->values[index] % WORD_BITS);
+            }
+            container->words[word] &= mask;
+        }
+        container->size = bitmapCombine(NULL, container->words, container->words, BITMAP_AND);
+    }
+    containerNormalize(container);
+}
+
+static void containerSubtract(Container *container, const Container *other)
+{
+    if (container->words == NULL)
+    {
+        arrayFilter(container, other, false);
+        return;
+    }
+    if (other->words != NULL)
+    {
+        container->size = bitmapCombine(container->words, container->words, other->words, BITMAP_AND_NOT);
+    }
+    else
+    {
+        for (int i = 0; i < other->size; i++)
+        {
+            if (bitmapContains(container->words, other->values[i]))
+            {
+                bitmapClear(container->words, other->values[i]);
+                container->size--;
+            }
+        }
+    }
+    containerNormalize(container);
+}
+
+static AttendeeSetResult containerUnite(Container *container, const Container *other)
+{
+    if (container->words == NULL && other->words != NULL)
+    {
+        Container united;
+        if (containerCopy(&united, other) == ATTENDEE_SET_OUT_OF_MEMORY)
+        {
+            return ATTENDEE_SET_OUT_OF_MEMORY;
+        }
+        for (int i = 0; i < container->size; i++)
+        {
+            united.size += !bitmapContains(united.words, container->values[i]);
+            bitmapSet(united.words, container->values[i]);
+        }
+        united.key = container->key;
+        containerFree(container);
+        *container = united;
+        return ATTENDEE_SET_SUCCESS;
+    }
+    if (container->words != NULL)
+    {
+        if (other->words != NULL)
+        {
+            container->size = bitmapCombine(container->words, container->words, other->words, BITMAP_OR);
+            return ATTENDEE_SET_SUCCESS;
+        }
+        for (int i = 0; i < other->size; i++)
+        {
+            container->size += !bitmapContains(container->words, other->values[i]);
+            bitmapSet(container->words, other->values[i]);
+        }
+        return ATTENDEE_SET_SUCCESS;
+    }
+
+    int capacity = container->size + other->size;
+    uint16_t *values = malloc(capacity * sizeof(*values));
+    if (values == NULL)
+    {
+        return ATTENDEE_SET_OUT_OF_MEMORY;
+    }
+    int i = 0;
+    int j = 0;
+    int count = 0;
+    while (i < container->size || j < other->size)
+    {
+        if (j == other->size || (i < container->size && container->values[i] < other->values[j]))
+        {
+            values[count++] = container->values[i++];
+        }
+        else
+        {
+            i += i < container->size && container->values[i] == other->values[j];
+            values[count++] = other->values[j++];
+        }
+    }
+    free(container->values);
+    container->values = values;
+    container->capacity = capacity;
+    container->size = count;
+    containerNormalize(container);
+    return ATTENDEE_SET_SUCCESS;
+}
+
+/** Returns the position of the first container whose key is not smaller than key */
+static int findContainer(AttendeeSet set, int key)
+{
+    int begin = 0;
+    int end = set->count;
+    while (begin < end)
+    {
+        int middle = begin + (end - begin) / 2;
+        if (set->containers[middle].key < key)
+        {
+            begin = middle + 1;
+        }
+        else
+        {
+            end = middle;
+        }
+    }
+    return begin;
+}
+
+static bool reserveContainers(AttendeeSet set, int count)
+{
+    if (count <= set->capacity)
+    {
+        return true;
+    }
+    int capacity = set->capacity < MIN_SET_CAPACITY ? MIN_SET_CAPACITY : set->capacity;
+    while (capacity < count)
+    {
+        capacity *= EXPAND_FACTOR;
+    }
+    Container *containers = realloc(set->containers, capacity * sizeof(*containers));
+    if (containers == NULL)
+    {
+        return false;
+    }
+    set->containers = containers;
+    set->capacity = capacity;
+    return true;
+}
+
+static void removeContainer(AttendeeSet set, int index)
+{
+    containerFree(&set->containers[index]);
+    memmove(set->containers + index, set->containers + index + 1,
+            (set->count - index - 1) * sizeof(*set->containers));
+    set->count--;
+}
+
+/** Drops the containers left empty by a set operation and recounts the set */
+static void compactContainers(AttendeeSet set)
+{
+    int count = 0;
+    set->size = 0;
+    for (int i = 0; i < set->count; i++)
+    {
+        if (set->containers[i].size == 0)
+        {
+            containerFree(&set->containers[i]);
+            continue;
+        }
+        set->size += set->containers[i].size;
+        set->containers[count++] = set->containers[i];
+    }
+    set->count = count;
+}
+
+static bool hasContainer(AttendeeSet set, int index, int key)
+{
+    return index < set->count && set->containers[index].key == key;
+}
+
+AttendeeSet attendeeSetCreate(void)
+{
+    AttendeeSet set = malloc(sizeof(*set));
+    if (set == NULL)
+    {
+        return NULL;
+    }
+    set->size = 0;
+    set->count = 0;
+    set->capacity = 0;
+    set->containers = NULL;
+    return set;
+}
+
+void attendeeSetDestroy(AttendeeSet set)
+{
+    if (set == NULL)
+    {
+        return;
+    }
+    for (int i = 0; i < set->count; i++)
+    {
+        containerFree(&set->containers[i]);
+    }
+    free(set->containers);
+    free(set);
+}
+
+AttendeeSet attendeeSetCopy(AttendeeSet set)
+{
+    if (set == NULL)
+    {
+        return NULL;
+    }
+    AttendeeSet new_set = attendeeSetCreate();
+    if (new_set == NULL || !reserveContainers(new_set, set->count))
+    {
+        attendeeSetDestroy(new_set);
+        return NULL;
+    }
+    for (int i = 0; i < set->count; i++)
+    {
+        if (containerCopy(&new_set->containers[i], &set->containers[i]) == ATTENDEE_SET_OUT_OF_MEMORY)
+        {
+            containerFree(&new_set->containers[i]);
+            attendeeSetDestroy(new_set);
+            return NULL;
+        }
+        new_set->count++;
+    }
+    new_set->size = set->size;
+    return new_set;
+}
+
+AttendeeSetResult attendeeSetAdd(AttendeeSet set, int id)
+{
+    if (set == NULL)
+    {
+        return ATTENDEE_SET_NULL_ARGUMENT;
+    }
+    if (id < 0)
+    {
+        return ATTENDEE_SET_INVALID_ID;
+    }
+    int key = id >> CONTAINER_BITS;
+    int index = findContainer(set, key);
+    if (!hasContainer(set, index, key))
+    {
+        if (!reserveContainers(set, set->count + 1))
+        {
+            return ATTENDEE_SET_OUT_OF_MEMORY;
+        }
+        memmove(set->containers + index + 1, set->containers + index,
+                (set->count - index) * sizeof(*set->containers));
+        set->containers[index] = (Container){(uint16_t)key, 0, 0, NULL, NULL};
+        set->count++;
+    }
+    AttendeeSetResult result = containerAdd(&set->containers[index], (uint16_t)(id & LOW_MASK));
+    if (result == ATTENDEE_SET_SUCCESS)
+    {
+        set->size++;
+    }
+    else if (set->containers[index].size == 0)
+    {
+        removeContainer(set, index);
+    }
+    return result;
+}
+
+AttendeeSetResult attendeeSetRemove(AttendeeSet set, int id)
+{
+    if (set == NULL)
+    {
+        return ATTENDEE_SET_NULL_ARGUMENT;
+    }
+    if (!attendeeSetContains(set, id))
+    {
+        return ATTENDEE_SET_ID_DOES_NOT_EXIST;
+    }
+    int index = findContainer(set, id >> CONTAINER_BITS);
+    containerRemove(&set->containers[index], (uint16_t)(id & LOW_MASK));
+    set->size--;
+    if (set->containers[index].size == 0)
+    {
+        removeContainer(set, index);
+    }
+    return ATTENDEE_SET_SUCCESS;
+}
+
+bool attendeeSetContains(AttendeeSet set, int id)
+{
+    if (set == NULL || id < 0)
+    {
+        return false;
+    }
+    int key = id >> CONTAINER_BITS;
+    int index = findContainer(set, key);
+    return hasContainer(set, index, key) && containerContains(&set->containers[index], (uint16_t)(id & LOW_MASK));
+}
+
+int attendeeSetGetSize(AttendeeSet set)
+{
+    if (set == NULL)
+    {
+        return -1;
+    }
+    return set->size;
+}
+
+int attendeeSetGetFirst(AttendeeSet set)
+{
+    return attendeeSetGetNext(set, -1);
+}
+
+int attendeeSetGetNext(AttendeeSet set, int id)
+{
+    if (set == NULL || id == INT32_MAX)
+    {
+        return ATTENDEE_SET_NO_ID;
+    }
+    int next = id < 0 ? 0 : id + 1;
+    int key = next >> CONTAINER_BITS;
+    int index = findContainer(set, key);
+    if (hasContainer(set, index, key))
+    {
+        int low = containerNext(&set->containers[index], next & LOW_MASK);
+        if (low >= 0)
+        {
+            return (key << CONTAINER_BITS) | low;
+        }
+        index++;
+    }
+    if (index == set->count)
+    {
+        return ATTENDEE_SET_NO_ID;
+    }
+    return (set->containers[index].key << CONTAINER_BITS) | containerNext(&set->containers[index], 0);
+}
+
+int attendeeSetGetNextIds(AttendeeSet set, int id, int *ids, int size)
+{
+    if (set == NULL || ids == NULL || size < 0)
+    {
+        return -1;
+    }
+    if (id == INT32_MAX)
+    {
+        return 0;
+    }
+    int next = id < 0 ? 0 : id + 1;
+    int count = 0;
+    for (int index = findContainer(set, next >> CONTAINER_BITS); index < set->count && count < size; index++)
+    {
+        const Container *container = &set->containers[index];
+        int high = container->key << CONTAINER_BITS;
+        int low = container->key == next >> CONTAINER_BITS ? next & LOW_MASK : 0;
+        if (container->words == NULL)
+        {
+            for (int i = arrayLowerBound(container, low); i < container->size && count < size; i++)
+            {
+                ids[count++] = high | container->values[i];
+            }
+            continue;
+        }
+        int word = low / WORD_BITS;
+        uint64_t bits = container->words[word] & (~(uint64_t)0 << (low % WORD_BITS));
+        while (count < size)
+        {
+            if (bits != 0)
+            {
+                ids[count++] = high | (word * WORD_BITS + lowestBit(bits));
+                bits &= bits - 1;
+            }
+            else if (++word < BITMAP_WORDS)
+            {
+                bits = container->words[word];
+            }
+            else
+            {
+                break;
+            }
+        }
+    }
+    return count;
+}
+
+int attendeeSetGetIntersectionSize(AttendeeSet set1, AttendeeSet set2)
+{
+    if (set1 == NULL || set2 == NULL)
+    {
+        return -1;
+    }
+    int count = 0;
+    int i = 0;
+    int j = 0;
+    while (i < set1->count && j < set2->count)
+    {
+        if (set1->containers[i].key < set2->containers[j].key)
+        {
+            i++;
+        }
+        else if (set1->containers[i].key > set2->containers[j].key)
+        {
+            j++;
+        }
+        else
+        {
+            count += containerIntersectionCount(&set1->containers[i++], &set2->containers[j++]);
+        }
+    }
+    return count;
+}
+
+int attendeeSetGetUnionSize(AttendeeSet set1, AttendeeSet set2)
+{
+    int common = attendeeSetGetIntersectionSize(set1, set2);
+    return common < 0 ? -1 : set1->size + set2->size - common;
+}
+
+int attendeeSetGetDifferenceSize(AttendeeSet set1, AttendeeSet set2)
+{
+    int common = attendeeSetGetIntersectionSize(set1, set2);
+    return common < 0 ? -1 : set1->size - common;
+}
+
+AttendeeSetResult attendeeSetIntersect(AttendeeSet set, AttendeeSet other)
+{
+    if (set == NULL || other == NULL)
+    {
+        return ATTENDEE_SET_NULL_ARGUMENT;
+    }
+    for (int i = 0; i < set->count; i++)
+    {
+        Container *container = &set->containers[i];
+        int j = findContainer(other, container->key);
+        if (hasContainer(other, j, container->key))
+        {
+            containerIntersect(container, &other->containers[j]);
+        }
+        else
+        {
+            container->size = 0;
+        }
+    }
+    compactContainers(set);
+    return ATTENDEE_SET_SUCCESS;
+}
+
+AttendeeSetResult attendeeSetSubtract(AttendeeSet set, AttendeeSet other)
+{
+    if (set == NULL || other == NULL)
+    {
+        return ATTENDEE_SET_NULL_ARGUMENT;
+    }
+    for (int i = 0; i < set->count; i++)
+    {
+        Container *container = &set->containers[i];
+        int j = findContainer(other, container->key);
+        if (set == other)
+        {
+            container->size = 0;
+        }
+        else if (hasContainer(other, j, container->key))
+        {
+            containerSubtract(container, &other->containers[j]);
+        }
+    }
+    compactContainers(set);
+    return ATTENDEE_SET_SUCCESS;
+}
+
+AttendeeSetResult attendeeSetUnite(AttendeeSet set, AttendeeSet other)
+{
+    if (set == NULL || other == NULL)
+    {
+        return ATTENDEE_SET_NULL_ARGUMENT;
+    }
+    if (!reserveContainers(set, set->count + other->count))
+    {
+        return ATTENDEE_SET_OUT_OF_MEMORY;
+    }
+    AttendeeSetResult result = ATTENDEE_SET_SUCCESS;
+    for (int j = 0; j < other->count && result == ATTENDEE_SET_SUCCESS; j++)
+    {
+        const Container *container = &other->containers[j];
+        int i = findContainer(set, container->key);
+        if (hasContainer(set, i, container->key))
+        {
+            result = containerUnite(&set->containers[i], container);
+            continue;
+        }
+        Container copy;
+        result = containerCopy(&copy, container);
+        if (result == ATTENDEE_SET_OUT_OF_MEMORY)
+        {
+            containerFree(&copy);
+            break;
+        }
+        memmove(set->containers + i + 1, set->containers + i, (set->count - i) * sizeof(*set->containers));
+        set->containers[i] = copy;
+        set->count++;
+    }
+    compactContainers(set);
+    return result;
+}
@@ -0,0 +1,243 @@
+#ifndef ATTENDEE_SET_H_
+#define ATTENDEE_SET_H_
+
+#include <stdbool.h>
+
+/**
+* Attendee Set
+*
+* Implements a set of non-negative ids, used to store the members who attend an event and
+* the events a member attends.
+* The set is a roaring bitmap: ids are grouped by their high 16 bits, and each group keeps
+* its low 16 bits as a sorted array while sparse and as a bitmap while dense.
+* Counting and combining sets work group by group, using SIMD where it is available.
+*
+* The following functions are available:
+*   attendeeSetCreate       - Allocates a new empty set.
+*   attendeeSetDestroy      - Deallocates an existing set.
+*   attendeeSetCopy         - Creates a copy of target set.
+*   attendeeSetAdd          - Adds an id to the set.
+*   attendeeSetRemove       - Removes an id from the set.
+*   attendeeSetContains     - Checks if an id is in the set.
+*   attendeeSetGetSize      - Returns the number of ids in the set.
+*   attendeeSetGetFirst     - Returns the smallest id in the set.
+*   attendeeSetGetNext      - Returns the smallest id in the set that is larger than a given id.
+*   attendeeSetGetNextIds   - Copies the ids of the set that are larger than a given id.
+*   attendeeSetGetIntersectionSize - Returns the number of ids in both of two sets.
+*   attendeeSetGetUnionSize - Returns the number of ids in either of two sets.
+*   attendeeSetGetDifferenceSize - Returns the number of ids in a set that are not in another.
+*   attendeeSetIntersect    - Removes the ids of a set that are not in another.
+*   attendeeSetUnite        - Adds the ids of another set to a set.
+*   attendeeSetSubtract     - Removes the ids of another set from a set.
+* 	ATTENDEE_SET_FOREACH    - A macro for iterating over the ids of the set in ascending order.
+*/
+
+/** Type for defining the attendee set */
+typedef struct AttendeeSet_t *AttendeeSet;
+
+/** Type used for returning error codes from attendee set functions */
+typedef enum AttendeeSetResult_t
+{
+    ATTENDEE_SET_SUCCESS,
+    ATTENDEE_SET_OUT_OF_MEMORY,
+    ATTENDEE_SET_NULL_ARGUMENT,
+    ATTENDEE_SET_INVALID_ID,
+    ATTENDEE_SET_ID_ALREADY_EXISTS,
+    ATTENDEE_SET_ID_DOES_NOT_EXIST
+} AttendeeSetResult;
+
+/** Returned by attendeeSetGetFirst and attendeeSetGetNext when there is no such id */
+#define ATTENDEE_SET_NO_ID -1
+
+/**
+* attendeeSetCreate: Allocates a new empty set.
+*
+* @return
+* 	NULL - if allocation failed.
+* 	A new set in case of success.
+*/
+AttendeeSet attendeeSetCreate(void);
+
+/**
+* attendeeSetDestroy: Deallocates an existing set.
+*
+* @param set - Target set to be deallocated. If set is NULL nothing will be done.
+*/
+void attendeeSetDestroy(AttendeeSet set);
+
+/**
+* attendeeSetCopy: Creates a copy of target set.
+*
+* @param set - Target set.
+* @return
+* 	NULL if a NULL was sent or a memory allocation failed.
+* 	A set containing the same ids as set otherwise.
+*/
+AttendeeSet attendeeSetCopy(AttendeeSet set);
+
+/**
+* attendeeSetAdd: Adds an id to the set, in O(log n), not counting the shift of the larger
+* ids of its group while the group is an array.
+*
+* @param set - The set to add the id to.
+* @param id - The id to add.
+* @return
+* 	ATTENDEE_SET_NULL_ARGUMENT if a NULL was sent as set.
+* 	ATTENDEE_SET_INVALID_ID if id is negative.
+* 	ATTENDEE_SET_ID_ALREADY_EXISTS if id is already in the set.
+* 	ATTENDEE_SET_OUT_OF_MEMORY if an allocation failed, the set is unchanged.
+* 	ATTENDEE_SET_SUCCESS if the id had been added successfully.
+*/
+AttendeeSetResult attendeeSetAdd(AttendeeSet set, int id);
+
+/**
+* attendeeSetRemove: Removes an id from the set.
+*
+* @param set - The set to remove the id from.
+* @param id - The id to remove.
+* @return
+* 	ATTENDEE_SET_NULL_ARGUMENT if a NULL was sent as set.
+* 	ATTENDEE_SET_ID_DOES_NOT_EXIST if id is not in the set.
+* 	ATTENDEE_SET_SUCCESS if the id had been removed successfully.
+*/
+AttendeeSetResult attendeeSetRemove(AttendeeSet set, int id);
+
+/**
+* attendeeSetContains: Checks if an id is in the set, in O(log n).
+*
+* @param set - The set to search in.
+* @param id - The id to look for.
+* @return
+* 	false if a NULL was sent as set or id is not in the set.
+* 	true otherwise.
+*/
+bool attendeeSetContains(AttendeeSet set, int id);
+
+/**
+* attendeeSetGetSize: Returns the number of ids in the set.
+*
+* @param set - The set whose size is requested.
+* @return
+* 	-1 if a NULL pointer was sent.
+* 	Otherwise the number of ids in the set.
+*/
+int attendeeSetGetSize(AttendeeSet set);
+
+/**
+* attendeeSetGetFirst: Returns the smallest id in the set.
+*
+* @param set - The set to start iterating over.
+* @return
+* 	ATTENDEE_SET_NO_ID if a NULL pointer was sent or the set is empty.
+* 	The smallest id in the set otherwise.
+*/
+int attendeeSetGetFirst(AttendeeSet set);
+
+/**
+* attendeeSetGetNext: Returns the smallest id in the set that is larger than id.
+* The set has no internal iterator, so several iterations may run at the same time.
+*
+* @param set - The set being iterated over.
+* @param id - The id returned by the previous call.
+* @return
+* 	ATTENDEE_SET_NO_ID if a NULL pointer was sent or there is no larger id.
+* 	The next id in the set otherwise.
+*/
+int attendeeSetGetNext(AttendeeSet set, int id);
+
+/**
+* attendeeSetGetNextIds: Copies the ids of the set that are larger than id, in ascending
+* order, up to size of them. Copying the whole set in batches costs O(n) plus O(log n) for
+* each batch, and a batch that ends before size means there are no more ids.
+*
+* @param set - The set being iterated over.
+* @param id - The last id copied by the previous call, or -1 to start from the beginning.
+* @param ids - Array of at least size ids to copy into.
+* @param size - The largest number of ids to copy.
+* @return
+* 	-1 if a NULL pointer was sent or size is negative.
+* 	Otherwise the number of ids copied.
+*/
+int attendeeSetGetNextIds(AttendeeSet set, int id, int *ids, int size);
+
+/**
+* attendeeSetGetIntersectionSize: Returns the number of ids in both of two sets, without
+* building their intersection.
+*
+* @param set1 - The first set.
+* @param set2 - The second set.
+* @return
+* 	-1 if a NULL pointer was sent.
+* 	Otherwise the number of ids in both sets.
+*/
+int attendeeSetGetIntersectionSize(AttendeeSet set1, AttendeeSet set2);
+
+/**
+* attendeeSetGetUnionSize: Returns the number of ids in either of two sets, without
+* building their union.
+*
+* @param set1 - The first set.
+* @param set2 - The second set.
+* @return
+* 	-1 if a NULL pointer was sent.
+* 	Otherwise the number of ids in at least one of the sets.
+*/
+int attendeeSetGetUnionSize(AttendeeSet set1, AttendeeSet set2);
+
+/**
+* attendeeSetGetDifferenceSize: Returns the number of ids in a set that are not in another,
+* without building their difference.
+*
+* @param set1 - The set whose ids are counted.
+* @param set2 - The set whose ids are not counted.
+* @return
+* 	-1 if a NULL pointer was sent.
+* 	Otherwise the number of ids in set1 that are not in set2.
+*/
+int attendeeSetGetDifferenceSize(AttendeeSet set1, AttendeeSet set2);
+
+/**
+* attendeeSetIntersect: Removes the ids of a set that are not in another.
+*
+* @param set - The set to change.
+* @param other - The set whose ids are kept. It is not changed.
+* @return
+* 	ATTENDEE_SET_NULL_ARGUMENT if a NULL was sent.
+* 	ATTENDEE_SET_SUCCESS otherwise.
+*/
+AttendeeSetResult attendeeSetIntersect(AttendeeSet set, AttendeeSet other);
+
+/**
+* attendeeSetUnite: Adds the ids of another set to a set.
+*
+* @param set - The set to change.
+* @param other - The set whose ids are added. It is not changed.
+* @return
+* 	ATTENDEE_SET_NULL_ARGUMENT if a NULL was sent.
+* 	ATTENDEE_SET_OUT_OF_MEMORY if an allocation failed, set keeps its ids and may have
+* 	gained only part of the ids of other.
+* 	ATTENDEE_SET_SUCCESS otherwise.
+*/
+AttendeeSetResult attendeeSetUnite(AttendeeSet set, AttendeeSet other);
+
+/**
+* attendeeSetSubtract: Removes the ids of another set from a set.
+*
+* @param set - The set to change.
+* @param other - The set whose ids are removed. It is not changed.
+* @return
+* 	ATTENDEE_SET_NULL_ARGUMENT if a NULL was sent.
+* 	ATTENDEE_SET_SUCCESS otherwise.
+*/
+AttendeeSetResult attendeeSetSubtract(AttendeeSet set, AttendeeSet other);
+
+/*!
+* Macro for iterating over the ids of the set in ascending order.
+* Declares a new int iterator for the loop.
+*/
+#define ATTENDEE_SET_FOREACH(iterator, set)               \
+    for (int iterator = attendeeSetGetFirst(set);         \
+         iterator != ATTENDEE_SET_NO_ID;                  \
+         iterator = attendeeSetGetNext(set, iterator))
+
+#endif /* ATTENDEE_SET_H_ */
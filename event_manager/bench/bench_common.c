@@ -0,0 +1,51 @@
+#define _POSIX_C_SOURCE 199309L
+#include "bench_common.h"
+#include <stdbool.h>
+#include <stdlib.h>
+#include <time.h>
+
+static bool first_record = true;
+
+long long nowNanoseconds(void)
+{
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return time.tv_sec * NANO_IN_SECOND + time.tv_nsec;
+}
+
+int randomInt(int bound)
+{
+    return (int)(((double)rand() / ((double)RAND_MAX + 1)) * bound);
+}
+
+int compareLongLongs(const void *n1, const void *n2)
+{
+    long long a = *(const long long *)n1;
+    long long b = *(const long long *)n2;
+    return (a > b) - (a < b);
+}
+
+LatencySummary summarizeLatencies(long long *samples, int count)
+{
+    LatencySummary summary = {0, 0, 0, 0};
+    for (int i = 0; i < count; i++)
+    {
+        summary.total += samples[i];
+    }
+    if (count == 0)
+    {
+        return summary;
+    }
+    qsort(samples, count, sizeof(*samples), compareLongLongs);
+    summary.p50 = samples[count / 2];
+    summary.p99 = samples[(int)((count - 1) * 0.99)];
+    summary.ops_per_second = summary.total > 0 ? (double)count * NANO_IN_SECOND / summary.total : 0;
+    return summary;
+}
+
+const char *nextRecordSeparator(void)
+{
+    const char *separator = first_record ? "" : ",";
+    first_record = false;
+    return separator;
+}
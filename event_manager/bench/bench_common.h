@@ -0,0 +1,70 @@
+#ifndef BENCH_COMMON_H_
+#define BENCH_COMMON_H_
+
+/**
+* Benchmark helpers
+*
+* Timing, random numbers and latency statistics shared by the benchmarks. Every
+* benchmark prints its results to stdout as a JSON array of records.
+*
+* The following functions are available:
+*   nowNanoseconds          - Returns the time of a monotonic clock in nanoseconds.
+*   randomInt               - Returns a random number in a range starting at 0.
+*   compareLongLongs        - qsort comparison of long long values.
+*   summarizeLatencies      - Returns the total, throughput and percentiles of latency samples.
+*   nextRecordSeparator     - Returns the text to print before the next JSON record.
+*/
+
+#define NANO_IN_SECOND 1000000000LL
+
+/** Statistics of a set of per-operation latency samples, in nanoseconds */
+typedef struct LatencySummary_t
+{
+    long long total;
+    double ops_per_second;
+    long long p50;
+    long long p99;
+} LatencySummary;
+
+/**
+* nowNanoseconds: Returns the time of a monotonic clock in nanoseconds, only the difference
+* between two calls is meaningful.
+*/
+long long nowNanoseconds(void);
+
+/**
+* randomInt: Returns a random number from rand, spread evenly over the range.
+*
+* @param bound - The end of the range, must be positive.
+* @return
+* 	A number between 0 and bound - 1.
+*/
+int randomInt(int bound);
+
+/**
+* compareLongLongs: Compares two long long values, for sorting them with qsort.
+*
+* @return
+* 	A negative number if the first value is smaller, 0 if they are equal and a positive
+* 	number otherwise.
+*/
+int compareLongLongs(const void *n1, const void *n2);
+
+/**
+* summarizeLatencies: Returns the statistics of latency samples. The samples are sorted in
+* place to find the percentiles.
+*
+* @param samples - The latency of each operation.
+* @param count - The number of samples.
+* @return
+* 	The summary of the samples, all zero if count is 0.
+*/
+LatencySummary summarizeLatencies(long long *samples, int count);
+
+/**
+* nextRecordSeparator: Returns the text to print before the next record of the JSON array,
+* nothing before the first record and a comma before every other one.
+*/
+const char *nextRecordSeparator(void);
+
+#endif /* BENCH_COMMON_H_ */
@@ -0,0 +1,201 @@
+#include "../date.h"
+#include "bench_common.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+/**
+* Date benchmark
+*
+* Compares counting dates in a range and counting dates per month done one Date at a
+* time (dateCompare, dateGet) against the batch kernels working on an array of date
+* values (dateCountInRange, dateBucketByMonth), including the cost of gathering the
+* values with dateSerialsFromArray. It also compares dateFormat and dateValueParse with
+* snprintf and sscanf on the "day.month.year" text of the same dates. Each measurement
+* is the best of ROUNDS runs. Results are printed to stdout as a JSON array, one record
+* per (size, operation).
+*
+* Usage: date_bench [max_size]
+*   max_size - largest number of dates to measure, defaults to DEFAULT_MAX_SIZE.
+*/
+
+#define DEFAULT_MAX_SIZE 1000000
+#define LIMIT_MAX_SIZE 10000000
+#define MIN_SIZE 1000
+#define SIZE_STEP 10
+#define ROUNDS 5
+#define FIRST_YEAR 2000
+#define YEAR_RANGE 10
+
+typedef enum Operation_t
+{
+    OP_COMPARE_LOOP,
+    OP_GATHER,
+    OP_COUNT_IN_RANGE,
+    OP_GET_LOOP,
+    OP_BUCKET_BY_MONTH,
+    OP_SNPRINTF,
+    OP_FORMAT,
+    OP_SSCANF,
+    OP_PARSE,
+    OP_COUNT
+} Operation;
+
+static const char *operation_names[OP_COUNT] = {"compare_loop", "serials_from_array", "count_in_range",
+                                                "get_loop", "bucket_by_month", "snprintf", "format",
+                                                "sscanf", "parse"};
+
+/** Keeps the results alive so the measured loops are not optimized away */
+static volatile long long sink = 0;
+
+static void report(int size, Operation operation, long long total)
+{
+    printf("%s\n  {\"size\": %d, \"operation\": \"%s\", \"total_ns\": %lld, \"ns_per_date\": %.3f}",
+           nextRecordSeparator(), size, operation_names[operation], total, (double)total / size);
+}
+
+/**
+* texts holds size null terminated dates, text i starting at i * DATE_FORMAT_BUFFER_SIZE.
+* The formatting operations write into it and the parsing operations read from it.
+*/
+static void runOperation(Operation operation, Date *dates, DateValue *serials, char *texts, int size,
+                         Date lo, Date hi)
+{
+    int buckets[DATE_VALUE_MONTHS_IN_YEAR];
+    int count = 0;
+    int day, month, year;
+    DateValue value;
+    switch (operation)
+    {
+    case OP_COMPARE_LOOP:
+        for (int i = 0; i < size; i++)
+        {
+            count += dateCompare(dates[i], lo) >= 0 && dateCompare(dates[i], hi) <= 0;
+        }
+        break;
+    case OP_GATHER:
+        dateSerialsFromArray(dates, size, serials);
+        count = serials[size - 1];
+        break;
+    case OP_COUNT_IN_RANGE:
+        count = dateCountInRange(serials, size, dateSerial(lo), dateSerial(hi));
+        break;
+    case OP_GET_LOOP:
+        for (int i = 0; i < DATE_VALUE_MONTHS_IN_YEAR; i++)
+        {
+            buckets[i] = 0;
+        }
+        for (int i = 0; i < size; i++)
+        {
+            dateGet(dates[i], &day, &month, &year);
+            buckets[month - 1]++;
+        }
+        count = buckets[0];
+        break;
+    case OP_BUCKET_BY_MONTH:
+        dateBucketByMonth(serials, size, buckets);
+        count = buckets[0];
+        break;
+    case OP_SNPRINTF:
+        for (int i = 0; i < size; i++)
+        {
+            dateGet(dates[i], &day, &month, &year);
+            count += snprintf(texts + i * DATE_FORMAT_BUFFER_SIZE, DATE_FORMAT_BUFFER_SIZE, "%d.%d.%d",
+                              day, month, year);
+        }
+        break;
+    case OP_FORMAT:
+        for (int i = 0; i < size; i++)
+        {
+            count += dateFormat(dates[i], texts + i * DATE_FORMAT_BUFFER_SIZE);
+        }
+        break;
+    case OP_SSCANF:
+        for (int i = 0; i < size; i++)
+        {
+            count += sscanf(texts + i * DATE_FORMAT_BUFFER_SIZE, "%d.%d.%d", &day, &month, &year) == 3;
+        }
+        break;
+    default:
+        for (int i = 0; i < size; i++)
+        {
+            const char *text = texts + i * DATE_FORMAT_BUFFER_SIZE;
+            count += dateValueParse(text, strlen(text), &value);
+        }
+        break;
+    }
+    sink += count;
+}
+
+static bool benchmarkSize(int size)
+{
+    Date *dates = malloc(size * sizeof(*dates));
+    DateValue *serials = malloc(size * sizeof(*serials));
+    char *texts = malloc((size_t)size * DATE_FORMAT_BUFFER_SIZE);
+    Date lo = dateCreate(1, 3, FIRST_YEAR + 2);
+    Date hi = dateCreate(30, 8, FIRST_YEAR + 6);
+    int created = 0;
+    bool success = dates && serials && texts && lo && hi;
+    for (; success && created < size; created++)
+    {
+        dates[created] = dateCreate(randomInt(DATE_VALUE_DAYS_IN_MONTH) + 1,
+                                    randomInt(DATE_VALUE_MONTHS_IN_YEAR) + 1, FIRST_YEAR + randomInt(YEAR_RANGE));
+        success = dates[created] != NULL;
+    }
+
+    if (success)
+    {
+        dateSerialsFromArray(dates, size, serials);
+        for (int operation = 0; operation < OP_COUNT; operation++)
+        {
+            long long best = 0;
+            for (int round = 0; round < ROUNDS; round++)
+            {
+                long long start = nowNanoseconds();
+                runOperation((Operation)operation, dates, serials, texts, size, lo, hi);
+                long long elapsed = nowNanoseconds() - start;
+                best = round == 0 || elapsed < best ? elapsed : best;
+            }
+            report(size, (Operation)operation, best);
+        }
+    }
+
+    for (int i = 0; i < created; i++)
+    {
+        dateDestroy(dates[i]);
+    }
+    dateDestroy(lo);
+    dateDestroy(hi);
+    free(texts);
+    free(serials);
+    free(dates);
+    return success;
+}
+
+int main(int argc, char *argv[])
+{
+    int max_size = DEFAULT_MAX_SIZE;
+    if (argc == 2)
+    {
+        max_size = (int)strtol(argv[1], NULL, 10);
+    }
+    if (argc > 2 || max_size < MIN_SIZE || max_size > LIMIT_MAX_SIZE)
+    {
+        fprintf(stderr, "Usage: date_bench [max_size between %d and %d]\n", MIN_SIZE, LIMIT_MAX_SIZE);
+        return 1;
+    }
+
+    srand(0);
+    printf("[");
+    for (int size = MIN_SIZE; size <= max_size; size *= SIZE_STEP)
+    {
+        if (!benchmarkSize(size))
+        {
+            fprintf(stderr, "Out of memory at size %d\n", size);
+            printf("\n]\n");
+            return 1;
+        }
+    }
+    printf("\n]\n");
+    return 0;
+}
@@ -0,0 +1,150 @@
+#include "../event_manager.h"
+#include "bench_common.h"
+#include <stdlib.h>
+#include <stdio.h>
+
+/**
+* Event manager member benchmark
+*
+* Measures throughput and per-operation latency (p50/p99) of the event manager's per-member
+* operations for member counts from 10^3 up to a maximum (10^6 by default):
+*   add_member                - emAddMember of a new member.
+*   find_member               - emAddMember of an existing id, which only looks the member up.
+*   add_member_to_event       - emAddMemberToEvent of a random member and event.
+*   remove_member_from_event  - emRemoveMemberFromEvent of the links made above.
+*   remove_member             - emRemoveMember of a member linked to one event.
+* Results are printed to stdout as a JSON array, one record per (members, operation).
+*
+* Usage: em_bench [max_members]
+*   max_members - largest number of members to measure, defaults to DEFAULT_MAX_MEMBERS.
+*/
+
+#define DEFAULT_MAX_MEMBERS 1000000
+#define LIMIT_MAX_MEMBERS 10000000
+#define MIN_MEMBERS 1000
+#define MEMBERS_STEP 10
+#define PROBE_COUNT 100000
+#define LINK_COUNT 1000
+#define EVENT_COUNT 100
+
+/**
+* Prints one JSON record. The latency samples are sorted in place to find the percentiles.
+*/
+static void report(int members, const char *operation, long long *samples, int count)
+{
+    LatencySummary summary = summarizeLatencies(samples, count);
+    printf("%s\n  {\"members\": %d, \"operation\": \"%s\", \"ops\": %d, "
+           "\"total_ns\": %lld, \"ops_per_sec\": %.1f, \"p50_ns\": %lld, \"p99_ns\": %lld}",
+           nextRecordSeparator(), members, operation, count, summary.total, summary.ops_per_second,
+           summary.p50, summary.p99);
+}
+
+static bool benchmarkMembers(int members)
+{
+    int samples_size = members > PROBE_COUNT ? members : PROBE_COUNT;
+    long long *samples = malloc(samples_size * sizeof(*samples));
+    int *linked_members = malloc(LINK_COUNT * sizeof(*linked_members));
+    int *linked_events = malloc(LINK_COUNT * sizeof(*linked_events));
+    Date date = dateCreate(1, 1, 2000);
+    EventManager em = date ? createEventManager(date) : NULL;
+    bool success = samples && linked_members && linked_events && em;
+    for (int event_id = 0; success && event_id < EVENT_COUNT; event_id++)
+    {
+        success = emAddEventByDiff(em, "event", event_id, event_id) == EM_SUCCESS;
+    }
+
+    if (success)
+    {
+        for (int id = 0; success && id < members; id++)
+        {
+            long long start = nowNanoseconds();
+            success = emAddMember(em, "member", id) == EM_SUCCESS;
+            samples[id] = nowNanoseconds() - start;
+        }
+        report(members, "add_member", samples, members);
+    }
+
+    if (success)
+    {
+        for (int i = 0; i < PROBE_COUNT; i++)
+        {
+            int id = randomInt(members);
+            long long start = nowNanoseconds();
+            emAddMember(em, "member", id);
+            samples[i] = nowNanoseconds() - start;
+        }
+        report(members, "find_member", samples, PROBE_COUNT);
+
+        int links = 0;
+        for (int i = 0; i < LINK_COUNT; i++)
+        {
+            int member_id = randomInt(members);
+            int event_id = randomInt(EVENT_COUNT);
+            long long start = nowNanoseconds();
+            EventManagerResult result = emAddMemberToEvent(em, member_id, event_id);
+            long long elapsed = nowNanoseconds() - start;
+            if (result == EM_SUCCESS)
+            {
+                linked_members[links] = member_id;
+                linked_events[links] = event_id;
+                samples[links++] = elapsed;
+            }
+        }
+        report(members, "add_member_to_event", samples, links);
+
+        for (int i = 0; i < links; i++)
+        {
+            long long start = nowNanoseconds();
+            emRemoveMemberFromEvent(em, linked_members[i], linked_events[i]);
+            samples[i] = nowNanoseconds() - start;
+        }
+        report(members, "remove_member_from_event", samples, links);
+
+        for (int id = 0; id < LINK_COUNT; id++)
+        {
+            emAddMemberToEvent(em, id, id % EVENT_COUNT);
+        }
+        for (int id = 0; id < LINK_COUNT; id++)
+        {
+            long long start = nowNanoseconds();
+            emRemoveMember(em, id);
+            samples[id] = nowNanoseconds() - start;
+        }
+        report(members, "remove_member", samples, LINK_COUNT);
+    }
+
+    destroyEventManager(em);
+    dateDestroy(date);
+    free(linked_events);
+    free(linked_members);
+    free(samples);
+    return success;
+}
+
+int main(int argc, char *argv[])
+{
+    int max_members = DEFAULT_MAX_MEMBERS;
+    if (argc == 2)
+    {
+        max_members = (int)strtol(argv[1], NULL, 10);
+    }
+    if (argc > 2 || max_members < MIN_MEMBERS || max_members > LIMIT_MAX_MEMBERS)
+    {
+        fprintf(stderr, "Usage: em_bench [max_members between %d and %d]\n", MIN_MEMBERS, LIMIT_MAX_MEMBERS);
+        return 1;
+    }
+
+    srand(0);
+    printf("[");
+    for (int members = MIN_MEMBERS; members <= max_members; members *= MEMBERS_STEP)
+    {
+        if (!benchmarkMembers(members))
+        {
+            fprintf(stderr, "Out of memory at %d members\n", members);
+            printf("\n]\n");
+            return 1;
+        }
+    }
+    printf("\n]\n");
+    return 0;
+}
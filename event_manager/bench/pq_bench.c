@@ -0,0 +1,197 @@
+#include "../priority_queue.h"
+#include "bench_common.h"
+#include <stdlib.h>
+#include <stdio.h>
+
+/**
+* Priority queue benchmark
+*
+* Measures throughput and per-operation latency (p50/p99) of pqInsert, pqContains,
+* pqChangePriority, iteration and pqRemove for queue sizes from 10 up to a maximum
+* size (10^7 at most) over several priority distributions. Results are printed to
+* stdout as a JSON array, one record per (size, distribution, operation).
+*
+* Usage: pq_bench [max_size]
+*   max_size - largest queue size to measure, defaults to DEFAULT_MAX_SIZE.
+*/
+
+#define DEFAULT_MAX_SIZE 10000
+#define LIMIT_MAX_SIZE 10000000
+#define MIN_SIZE 10
+#define SIZE_STEP 10
+#define PROBE_COUNT 1000
+#define DUPLICATE_RANGE 16
+
+typedef enum Distribution_t
+{
+    DIST_ASCENDING,
+    DIST_DESCENDING,
+    DIST_RANDOM,
+    DIST_DUPLICATES,
+    DIST_COUNT
+} Distribution;
+
+static const char *distribution_names[DIST_COUNT] = {"ascending", "descending", "random", "duplicates"};
+
+static PQElement copyIntGeneric(PQElement n)
+{
+    int *copy = malloc(sizeof(*copy));
+    if (!copy)
+    {
+        return NULL;
+    }
+    *copy = *(int *)n;
+    return copy;
+}
+
+static void freeIntGeneric(PQElement n)
+{
+    free(n);
+}
+
+static bool equalIntsGeneric(PQElement n1, PQElement n2)
+{
+    return *(int *)n1 == *(int *)n2;
+}
+
+static int compareIntsGeneric(PQElementPriority n1, PQElementPriority n2)
+{
+    return (*(int *)n1 - *(int *)n2);
+}
+
+static void fillPriorities(int *priorities, int size, Distribution distribution)
+{
+    for (int i = 0; i < size; i++)
+    {
+        switch (distribution)
+        {
+        case DIST_ASCENDING:
+            priorities[i] = i;
+            break;
+        case DIST_DESCENDING:
+            priorities[i] = size - i;
+            break;
+        case DIST_RANDOM:
+            priorities[i] = randomInt(size);
+            break;
+        default:
+            priorities[i] = randomInt(DUPLICATE_RANGE);
+            break;
+        }
+    }
+}
+
+/**
+* Prints one JSON record. The latency samples are sorted in place to find the percentiles.
+*/
+static void report(int size, Distribution distribution, const char *operation, long long *samples, int count)
+{
+    LatencySummary summary = summarizeLatencies(samples, count);
+    printf("%s\n  {\"size\": %d, \"distribution\": \"%s\", \"operation\": \"%s\", \"ops\": %d, "
+           "\"total_ns\": %lld, \"ops_per_sec\": %.1f, \"p50_ns\": %lld, \"p99_ns\": %lld}",
+           nextRecordSeparator(), size, distribution_names[distribution], operation,
+           count, summary.total, summary.ops_per_second, summary.p50, summary.p99);
+}
+
+/**
+* Runs every operation on a queue of the given size. Elements are the ids 0..size-1 and
+* priorities[id] always holds the current priority of element id.
+*/
+static bool benchmarkSize(int size, Distribution distribution)
+{
+    int probes = size < PROBE_COUNT ? size : PROBE_COUNT;
+    int *priorities = malloc(size * sizeof(*priorities));
+    long long *samples = malloc(size * sizeof(*samples));
+    PriorityQueue queue = pqCreate(copyIntGeneric, freeIntGeneric, equalIntsGeneric,
+                                   copyIntGeneric, freeIntGeneric, compareIntsGeneric);
+    if (priorities == NULL || samples == NULL || queue == NULL)
+    {
+        free(priorities);
+        free(samples);
+        pqDestroy(queue);
+        return false;
+    }
+    fillPriorities(priorities, size, distribution);
+
+    for (int id = 0; id < size; id++)
+    {
+        long long start = nowNanoseconds();
+        pqInsert(queue, &id, &priorities[id]);
+        samples[id] = nowNanoseconds() - start;
+    }
+    report(size, distribution, "insert", samples, size);
+
+    for (int i = 0; i < probes; i++)
+    {
+        int id = randomInt(size);
+        long long start = nowNanoseconds();
+        pqContains(queue, &id);
+        samples[i] = nowNanoseconds() - start;
+    }
+    report(size, distribution, "contains", samples, probes);
+
+    for (int i = 0; i < probes; i++)
+    {
+        int id = randomInt(size);
+        int new_priority = distribution == DIST_DUPLICATES ? randomInt(DUPLICATE_RANGE) : randomInt(size);
+        long long start = nowNanoseconds();
+        pqChangePriority(queue, &id, &priorities[id], &new_priority);
+        samples[i] = nowNanoseconds() - start;
+        priorities[id] = new_priority;
+    }
+    report(size, distribution, "change_priority", samples, probes);
+
+    int visited = 0;
+    long long start = nowNanoseconds();
+    for (PQElement element = pqGetFirst(queue); element; element = pqGetNext(queue))
+    {
+        long long now = nowNanoseconds();
+        samples[visited++] = now - start;
+        start = now;
+    }
+    report(size, distribution, "iterate", samples, visited);
+
+    for (int i = 0; i < size; i++)
+    {
+        start = nowNanoseconds();
+        pqRemove(queue);
+        samples[i] = nowNanoseconds() - start;
+    }
+    report(size, distribution, "remove", samples, size);
+
+    pqDestroy(queue);
+    free(samples);
+    free(priorities);
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    int max_size = DEFAULT_MAX_SIZE;
+    if (argc == 2)
+    {
+        max_size = (int)strtol(argv[1], NULL, 10);
+    }
+    if (argc > 2 || max_size < MIN_SIZE || max_size > LIMIT_MAX_SIZE)
+    {
+        fprintf(stderr, "Usage: pq_bench [max_size between %d and %d]\n", MIN_SIZE, LIMIT_MAX_SIZE);
+        return 1;
+    }
+
+    srand(0);
+    printf("[");
+    for (int size = MIN_SIZE; size <= max_size; size *= SIZE_STEP)
+    {
+        for (int distribution = 0; distribution < DIST_COUNT; distribution++)
+        {
+            if (!benchmarkSize(size, (Distribution)distribution))
+            {
+                fprintf(stderr, "Out of memory at size %d\n", size);
+                printf("\n]\n");
+                return 1;
+            }
+        }
+    }
+    printf("\n]\n");
+    return 0;
+}
@@ -3,32 +3,45 @@
 #include <assert.h>
 #include <stdio.h>
 #include <string.h>
+#include <limits.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define DATE_USE_SSE2
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define DATE_USE_NEON
+#endif
 
 #define MIN_DAYS 1
 #define MAX_DAYS 30
 #define MIN_MONTH 1
 #define MAX_MONTH 12
-#define DAYS_IN_YEAR 365
+#define SIMD_LANES 4
+#define DECIMAL_BASE 10
+#define MAX_PARSED_DIGITS 9
+#define DATE_SEPARATOR '.'
 
-struct Date_t
-{
-    int day;
-    int month;
-    int year;
-};
+static const char digit_pairs[] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
 
 static bool checkIllegalDate(int day, int month, int year)
 {
-    if(day < MIN_DAYS || day > MAX_DAYS || month < MIN_MONTH || month > MAX_MONTH)
+    if(day < MIN_DAYS || day > MAX_DAYS || month < MIN_MONTH || month > MAX_MONTH ||
+       year < -DATE_VALUE_MAX_YEAR || year > DATE_VALUE_MAX_YEAR)
     {
         return true;
     }
     return false;
 }
 
-static int dateToDays(Date date)
+/** Returns the value of a legal date, checkIllegalDate keeps it within DateValue */
+static DateValue valueOfDate(int day, int month, int year)
 {
-    return (date->year * DAYS_IN_YEAR) + (date->month * MAX_DAYS) + date->day;
+    assert(!checkIllegalDate(day, month, year));
+    return year * DATE_VALUE_DAYS_IN_YEAR + (month - MIN_MONTH) * DATE_VALUE_DAYS_IN_MONTH + (day - MIN_DAYS);
 }
 
 Date dateCreate(int day, int month, int year)
@@ -42,9 +55,7 @@ Date dateCreate(int day, int month, int year)
     {
         return NULL;
     }
-    date->day = day;
-    date->month = month;
-    date->year = year;
+    date->serial = valueOfDate(day, month, year);
 
     return date;
 }
@@ -60,11 +71,12 @@ Date dateCopy(Date date)
     {
         return NULL;
     }
-    Date new_date = dateCreate(date->day, date->month, date->year);
+    Date new_date = malloc(sizeof(*new_date));
     if (!new_date)
     {
         return NULL;
     }
+    new_date->serial = date->serial;
     return new_date;
 }
 
@@ -74,9 +86,9 @@ bool dateGet(Date date, int *day, int *month, int *year)
     {
         return NULL;
     }
-    *day = date->day;
-    *month = date->month;
-    *year = date->year;
+    *day = dateValueDay(date->serial);
+    *month = dateValueMonth(date->serial);
+    *year = dateValueYear(date->serial);
     return true;
 }
 
@@ -86,7 +98,8 @@ int dateCompare(Date date1, Date date2)
     {
         return 0;
     }
-    return dateToDays(date1) - dateToDays(date2);
+    // not a subtraction, which overflows for dates far apart
+    return dateValueCompare(date1->serial, date2->serial);
 }
 
 void dateTick(Date date)
@@ -95,15 +108,258 @@ void dateTick(Date date)
     {
         return;
     }
-    date->day++;
-    if (date->day > MAX_DAYS)
+    date->serial = dateValueAddDays(date->serial, 1);
+}
+
+void dateAdvance(Date date, int days)
+{
+    if (!date)
+    {
+        return;
+    }
+    date->serial = dateValueAddDays(date->serial, days);
+}
+
+int dateDiffDays(Date date1, Date date2)
+{
+    if (!date1 || !date2)
+    {
+        return 0;
+    }
+    // 64 bit since dates far apart are more than INT_MAX days apart
+    int64_t days = (int64_t)date1->serial - date2->serial;
+    return days > INT_MAX ? INT_MAX : days < INT_MIN ? INT_MIN : (int)days;
+}
+
+Date dateValueToDate(DateValue value)
+{
+    if (value == DATE_VALUE_INVALID)
+    {
+        return NULL;
+    }
+    return dateCreate(dateValueDay(value), dateValueMonth(value), dateValueYear(value));
+}
+
+void dateSerialsFromArray(Date *dates, int count, DateValue *serials)
+{
+    if (!dates || !serials)
+    {
+        return;
+    }
+    for (int i = 0; i < count; i++)
+    {
+        serials[i] = dateSerial(dates[i]);
+    }
+}
+
+/** Counts the serials in [lo, hi] one at a time, used for the tail of the SIMD loops */
+static int countInRangeScalar(const DateValue *serials, int count, DateValue lo, DateValue hi)
+{
+    int in_range = 0;
+    for (int i = 0; i < count; i++)
+    {
+        in_range += serials[i] >= lo && serials[i] <= hi;
+    }
+    return in_range;
+}
+
+int dateCountInRange(const DateValue *serials, int count, DateValue lo, DateValue hi)
+{
+    if (!serials || count <= 0 || lo > hi)
+    {
+        return 0;
+    }
+    int i = 0;
+    int in_range = 0;
+#if defined(DATE_USE_SSE2)
+    // every lane of a comparison mask is 0 or -1, so subtracting the mask counts the matches
+    __m128i lows = _mm_set1_epi32(lo);
+    __m128i highs = _mm_set1_epi32(hi);
+    __m128i counts = _mm_setzero_si128();
+    for (; i + SIMD_LANES <= count; i += SIMD_LANES)
+    {
+        __m128i values = _mm_loadu_si128((const __m128i *)(serials + i));
+        __m128i outside = _mm_or_si128(_mm_cmplt_epi32(values, lows), _mm_cmpgt_epi32(values, highs));
+        counts = _mm_add_epi32(counts, _mm_andnot_si128(outside, _mm_set1_epi32(1)));
+    }
+    int32_t lanes[SIMD_LANES];
+    _mm_storeu_si128((__m128i *)lanes, counts);
+    in_range = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#elif defined(DATE_USE_NEON)
+    int32x4_t lows = vdupq_n_s32(lo);
+    int32x4_t highs = vdupq_n_s32(hi);
+    uint32x4_t counts = vdupq_n_u32(0);
+    for (; i + SIMD_LANES <= count; i += SIMD_LANES)
+    {
+        int32x4_t values = vld1q_s32(serials + i);
+        uint32x4_t inside = vandq_u32(vcgeq_s32(values, lows), vcleq_s32(values, highs));
+        counts = vsubq_u32(counts, inside);
+    }
+    in_range = (int)(vgetq_lane_u32(counts, 0) + vgetq_lane_u32(counts, 1) +
+                     vgetq_lane_u32(counts, 2) + vgetq_lane_u32(counts, 3));
+#endif
+    return in_range + countInRangeScalar(serials + i, count - i, lo, hi);
+}
+
+void dateBucketByMonth(const DateValue *serials, int count, int *buckets)
+{
+    if (!serials || !buckets)
+    {
+        return;
+    }
+    memset(buckets, 0, DATE_VALUE_MONTHS_IN_YEAR * sizeof(*buckets));
+    for (int i = 0; i < count; i++)
+    {
+        if (serials[i] != DATE_VALUE_INVALID)
+        {
+            buckets[dateValueMonth(serials[i]) - MIN_MONTH]++;
+        }
+    }
+}
+
+/** Writes n in decimal two digits at a time, returns the number of characters written */
+static int writeDecimal(char *buf, uint32_t n)
+{
+    char digits[DATE_FORMAT_BUFFER_SIZE];
+    int start = DATE_FORMAT_BUFFER_SIZE;
+    while (n >= DECIMAL_BASE * DECIMAL_BASE)
+    {
+        int pair = (int)(n % (DECIMAL_BASE * DECIMAL_BASE)) * 2;
+        n /= DECIMAL_BASE * DECIMAL_BASE;
+        digits[--start] = digit_pairs[pair + 1];
+        digits[--start] = digit_pairs[pair];
+    }
+    if (n >= DECIMAL_BASE)
+    {
+        digits[--start] = digit_pairs[n * 2 + 1];
+        digits[--start] = digit_pairs[n * 2];
+    }
+    else
+    {
+        digits[--start] = (char)('0' + n);
+    }
+    memcpy(buf, digits + start, DATE_FORMAT_BUFFER_SIZE - start);
+    return DATE_FORMAT_BUFFER_SIZE - start;
+}
+
+int dateValueFormat(DateValue value, char *buf)
+{
+    if (!buf)
+    {
+        return 0;
+    }
+    int year = dateValueYear(value);
+    int length = writeDecimal(buf, (uint32_t)dateValueDay(value));
+    buf[length++] = DATE_SEPARATOR;
+    length += writeDecimal(buf + length, (uint32_t)dateValueMonth(value));
+    buf[length++] = DATE_SEPARATOR;
+    if (year < 0)
+    {
+        buf[length++] = '-';
+    }
+    length += writeDecimal(buf + length, year < 0 ? 0u - (uint32_t)year : (uint32_t)year);
+    buf[length] = '\0';
+    return length;
+}
+
+int dateFormat(Date date, char *buf)
+{
+    if (!date || !buf)
+    {
+        return 0;
+    }
+    return dateValueFormat(date->serial, buf);
+}
+
+/**
+* Parses the decimal number starting at *position and moves position past it.
+* Returns false if there is no digit there or the number has too many digits.
+*/
+static bool parseDecimal(const char *text, size_t length, size_t *position, int *number)
+{
+    size_t start = *position;
+    int result = 0;
+    while (*position < length && (unsigned)(text[*position] - '0') < DECIMAL_BASE)
+    {
+        if (*position - start == MAX_PARSED_DIGITS)
+        {
+            return false;
+        }
+        result = result * DECIMAL_BASE + (text[*position] - '0');
+        (*position)++;
+    }
+    *number = result;
+    return *position > start;
+}
+
+static bool parseSeparator(const char *text, size_t length, size_t *position)
+{
+    if (*position >= length || text[*position] != DATE_SEPARATOR)
+    {
+        return false;
+    }
+    (*position)++;
+    return true;
+}
+
+bool dateValueParse(const char *text, size_t length, DateValue *value)
+{
+    if (!text || !value)
+    {
+        return false;
+    }
+    size_t position = 0;
+    int day, month, year;
+    if (!parseDecimal(text, length, &position, &day) || !parseSeparator(text, length, &position) ||
+        !parseDecimal(text, length, &position, &month) || !parseSeparator(text, length, &position))
+    {
+        return false;
+    }
+    bool negative = position < length && text[position] == '-';
+    position += negative;
+    if (!parseDecimal(text, length, &position, &year) || position != length)
+    {
+        return false;
+    }
+    // up to MAX_PARSED_DIGITS digits fit in an int, years beyond DATE_VALUE_MAX_YEAR are illegal
+    year = negative ? -year : year;
+    if (checkIllegalDate(day, month, year))
+    {
+        return false;
+    }
+    *value = valueOfDate(day, month, year);
+    return true;
+}
+
+bool dateParse(const char *text, size_t length, Date *date)
+{
+    DateValue value;
+    if (!date || !dateValueParse(text, length, &value))
+    {
+        return false;
+    }
+    *date = dateValueToDate(value);
+    return *date != NULL;
+}
+
+void dateRangeForEach(DateValue lo, DateValue hi, DateRunFunction fn, void *context)
+{
+    if (!fn)
+    {
+        return;
+    }
+    DateValue first = lo;
+    // 64 bit so a range spanning most of the DateValue range does not overflow
+    int64_t days_left = (int64_t)hi - lo + 1;
+    while (days_left > 0)
     {
-        date->day = 1;
-        date->month++;
-        if (date->month > MAX_MONTH)
+        int days_left_in_month = DATE_VALUE_DAYS_IN_MONTH - (dateValueDay(first) - MIN_DAYS);
+        int count = days_left < days_left_in_month ? (int)days_left : days_left_in_month;
+        fn(first, count, context);
+        days_left -= count;
+        if (days_left > 0)
         {
-            date->month = 1;
-            date->year++;
+            first += count;
         }
     }
-}
\ No newline at end of file
+}
@@ -2,10 +2,47 @@
 #define DATE_H_
 
 #include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
 
 /** Type for defining the date */
 typedef struct Date_t *Date;
 
+#define DATE_VALUE_DAYS_IN_MONTH 30
+#define DATE_VALUE_MONTHS_IN_YEAR 12
+#define DATE_VALUE_DAYS_IN_YEAR (DATE_VALUE_DAYS_IN_MONTH * DATE_VALUE_MONTHS_IN_YEAR)
+
+/** Size of a buffer large enough for any date written by dateFormat */
+#define DATE_FORMAT_BUFFER_SIZE 24
+
+/** DateValue returned for a NULL date, never equal to the value of a legal date */
+#define DATE_VALUE_INVALID INT32_MIN
+
+/**
+* Value type for a date: the number of days since 1.1.0 in the calendar of 12 months
+* of 30 days used by Date. Unlike Date it needs no allocation, is copied by assignment,
+* and dates are ordered like their values.
+*/
+typedef int32_t DateValue;
+
+/** The largest year of a legal date, the smallest one is -DATE_VALUE_MAX_YEAR */
+#define DATE_VALUE_MAX_YEAR ((INT32_MAX - (DATE_VALUE_DAYS_IN_YEAR - 1)) / DATE_VALUE_DAYS_IN_YEAR)
+
+/** The values of the last and the first legal dates */
+#define DATE_VALUE_MAX (DATE_VALUE_MAX_YEAR * DATE_VALUE_DAYS_IN_YEAR + DATE_VALUE_DAYS_IN_YEAR - 1)
+#define DATE_VALUE_MIN (-DATE_VALUE_MAX_YEAR * DATE_VALUE_DAYS_IN_YEAR)
+
+/**
+* A date is kept as its DateValue only: it orders like the date, comparing two dates
+* is a single subtraction and day, month and year are derived from it on demand.
+* The struct is defined here only so that dateSerial can be inlined; use the functions
+* below instead of its field.
+*/
+struct Date_t
+{
+    DateValue serial;
+};
+
 /**
 * dateCreate: Allocates a new date.
 *
@@ -13,7 +50,8 @@ typedef struct Date_t *Date;
 * @param month - the month of the date.
 * @param year - the year of the date.
 * @return
-* 	NULL - if allocation failed or date is illegal.
+* 	NULL - if allocation failed or date is illegal, including a year outside
+* 	-DATE_VALUE_MAX_YEAR to DATE_VALUE_MAX_YEAR, whose days do not fit in a DateValue.
 * 	A new Date in case of success.
 */
 Date dateCreate(int day, int month, int year);
@@ -61,10 +99,254 @@ int dateCompare(Date date1, Date date2);
 
 /**
 * dateTick: increases the date by one day, if date is NULL should do nothing.
+* The last legal date stays as it is.
 *
 * @param date - Target Date
 *
 */
 void dateTick(Date date);
 
+/**
+* dateAdvance: moves the date by the given number of days in constant time,
+* if date is NULL should do nothing.
+* A date moved past the first or the last legal date stops at it.
+*
+* @param date - Target Date
+* @param days - The number of days to move the date by, negative to move it backwards.
+*
+*/
+void dateAdvance(Date date, int days);
+
+/**
+* dateDiffDays: returns the number of days from date2 to date1.
+*
+* @return
+* 		A negative integer if date1 occurs first;
+* 		0 if they're equal or one of the given dates is NULL;
+*		A positive integer if date1 arrives after date2.
+*		Differences that do not fit in an int are clamped to INT_MIN or INT_MAX.
+*/
+int dateDiffDays(Date date1, Date date2);
+
+/**
+* dateSerial: Returns the value of a date.
+* Every Date stores its value and this is inline, so it is a single load and ordering
+* dates by their values costs one integer comparison.
+*
+* @param date - Target Date
+* @return
+* 	DATE_VALUE_INVALID if date is NULL.
+* 	Otherwise the value of the date.
+*/
+static inline DateValue dateSerial(Date date)
+{
+    return date ? date->serial : DATE_VALUE_INVALID;
+}
+
+/**
+* dateValueToDate: Allocates a new Date from a date value.
+*
+* @param value - The value of the date.
+* @return
+* 	NULL - if allocation failed or value is DATE_VALUE_INVALID.
+* 	A new Date in case of success.
+*/
+Date dateValueToDate(DateValue value);
+
+/**
+* dateSerialsFromArray: Writes the value of every date in an array into serials, so
+* analytics over many dates can run on the batch functions below instead of
+* comparing the dates one at a time.
+*
+* @param dates - Array of count dates, a NULL date gets DATE_VALUE_INVALID.
+* @param count - The number of dates.
+* @param serials - Array of at least count values to write into.
+*/
+void dateSerialsFromArray(Date *dates, int count, DateValue *serials);
+
+/**
+* dateCountInRange: Counts the date values between lo and hi, inclusive.
+* Uses SSE2 or NEON when the compiler targets them.
+*
+* @param serials - Array of count date values.
+* @param count - The number of values.
+* @param lo - The first date value of the range.
+* @param hi - The last date value of the range.
+* @return
+* 	0 if serials is NULL or lo is after hi.
+* 	Otherwise the number of values in the range.
+*/
+int dateCountInRange(const DateValue *serials, int count, DateValue lo, DateValue hi);
+
+/**
+* dateBucketByMonth: Counts the date values falling in each month of the year.
+* DATE_VALUE_INVALID values are skipped.
+*
+* @param serials - Array of count date values.
+* @param count - The number of values.
+* @param buckets - Array of DATE_VALUE_MONTHS_IN_YEAR counters, buckets[0] gets the
+* 		number of values in the first month.
+*/
+void dateBucketByMonth(const DateValue *serials, int count, int *buckets);
+
+/**
+* dateFormat: Writes a date as "day.month.year", the way it is printed in event files.
+* Unlike snprintf it does not depend on the locale.
+*
+* @param date - Target Date
+* @param buf - Buffer of at least DATE_FORMAT_BUFFER_SIZE characters, receives the
+* 		null terminated text.
+* @return
+* 	0 if a NULL pointer was sent.
+* 	Otherwise the length of the text without the null terminator.
+*/
+int dateFormat(Date date, char *buf);
+
+/**
+* dateValueFormat: Writes a date value as "day.month.year", same as dateFormat.
+*
+* @param value - The value of the date.
+* @param buf - Buffer of at least DATE_FORMAT_BUFFER_SIZE characters.
+* @return
+* 	0 if buf is NULL.
+* 	Otherwise the length of the text without the null terminator.
+*/
+int dateValueFormat(DateValue value, char *buf);
+
+/**
+* dateParse: Allocates a new Date from text of the form "day.month.year".
+* The whole text must be the date, without spaces or a null terminator; the year may be
+* negative.
+*
+* @param text - The text to parse, need not be null terminated.
+* @param length - The number of characters in text.
+* @param date - The pointer to assign the new Date into.
+* @return
+* 	false if a NULL pointer was sent, the text is not a legal date or allocation failed.
+* 	Otherwise true and the new Date is assigned to date.
+*/
+bool dateParse(const char *text, size_t length, Date *date);
+
+/**
+* dateValueParse: Parses text of the form "day.month.year" into a date value, same as
+* dateParse but without allocating.
+*
+* @return
+* 	false if a NULL pointer was sent or the text is not a legal date.
+* 	Otherwise true and the value is assigned to value.
+*/
+bool dateValueParse(const char *text, size_t length, DateValue *value);
+
+/** dateValueYear: Returns the year of a date value */
+static inline int dateValueYear(DateValue value)
+{
+    // rounds towards negative infinity, so dates before year 0 keep a month and day in range
+    return (value >= 0 ? value : value - (DATE_VALUE_DAYS_IN_YEAR - 1)) / DATE_VALUE_DAYS_IN_YEAR;
+}
+
+/** dateValueMonth: Returns the month of a date value */
+static inline int dateValueMonth(DateValue value)
+{
+    return (value - dateValueYear(value) * DATE_VALUE_DAYS_IN_YEAR) / DATE_VALUE_DAYS_IN_MONTH + 1;
+}
+
+/** dateValueDay: Returns the day of a date value */
+static inline int dateValueDay(DateValue value)
+{
+    return (value - dateValueYear(value) * DATE_VALUE_DAYS_IN_YEAR) % DATE_VALUE_DAYS_IN_MONTH + 1;
+}
+
+/**
+* dateValueCompare: compares two date values and returns which comes first
+*
+* @return
+* 		A negative integer if value1 occurs first;
+* 		0 if they're equal;
+*		A positive integer if value1 arrives after value2.
+*/
+static inline int dateValueCompare(DateValue value1, DateValue value2)
+{
+    return (value1 > value2) - (value1 < value2);
+}
+
+/**
+* dateValueAddDays: Returns the value of the date the given number of days after value.
+* A result before the first or after the last legal date is clamped to it.
+*/
+static inline DateValue dateValueAddDays(DateValue value, int days)
+{
+    // 64 bit so that adding a large number of days does not overflow
+    int64_t sum = (int64_t)value + days;
+    return sum > DATE_VALUE_MAX ? DATE_VALUE_MAX : sum < DATE_VALUE_MIN ? DATE_VALUE_MIN : (DateValue)sum;
+}
+
+/**
+* Iterator over the days from one date value to another, inclusive. It is a plain value:
+*
+* DateRange range = dateRangeBegin(lo, hi);
+* for (DateValue day; dateRangeNext(&range, &day);)
+* {
+*     ...
+* }
+*/
+typedef struct DateRange_t
+{
+    DateValue next;
+    DateValue last;
+} DateRange;
+
+/**
+* Type of function called by dateRangeForEach on every run of consecutive days.
+* The run holds the count days starting at first, all of them in the same month.
+* context is passed as is from the caller.
+*/
+typedef void (*DateRunFunction)(DateValue first, int count, void *context);
+
+/** dateRangeBegin: Returns an iterator over the days from lo to hi, empty if lo is after hi */
+static inline DateRange dateRangeBegin(DateValue lo, DateValue hi)
+{
+    DateRange range = {lo, hi};
+    return range;
+}
+
+/**
+* dateRangeNext: Moves a range iterator to its next day.
+*
+* @param range - The iterator to advance.
+* @param value - The pointer to assign the day into.
+* @return
+* 	false if the range has no days left.
+* 	Otherwise true and the day is assigned to value.
+*/
+static inline bool dateRangeNext(DateRange *range, DateValue *value)
+{
+    if (range->next > range->last)
+    {
+        return false;
+    }
+    *value = range->next;
+    if (range->next == range->last)
+    {
+        // ends the range without incrementing past the largest value
+        range->last--;
+    }
+    else
+    {
+        range->next++;
+    }
+    return true;
+}
+
+/**
+* dateRangeForEach: Calls fn on the days from lo to hi, inclusive, in runs of consecutive
+* days that do not cross a month boundary. Per day work can loop over a whole run at
+* once, and per month work gets one call per month.
+*
+* @param lo - The first day.
+* @param hi - The last day, nothing is done if it is before lo.
+* @param fn - The function to call on every run.
+* @param context - Passed as is to every call of fn.
+*/
+void dateRangeForEach(DateValue lo, DateValue hi, DateRunFunction fn, void *context);
+
 #endif //DATE_H_
@@ -3,12 +3,14 @@
 #include <string.h>
 #include <stdlib.h>
 #include <assert.h>
+#include <limits.h>
 
 #include "event_manager.h"
 #include "date.h"
 
 #define OK_EVENT_NAME "event_name"
 #define OK_EVENT_ID 50
+#define MAX_MEMBER_EVENTS 16
 
 /**
  * Evaluates expr and continues if expr is true.
@@ -95,7 +97,14 @@ bool isFilePrintOutputCorrect(char *file_name, char *expected_output) {
     return result;
 }
 
-
+/** Checks that the events of a member are exactly expected_ids, in ascending order */
+bool memberEventsAre(EventManager em, int member_id, const int *expected_ids, int amount) {
+    int event_ids[MAX_MEMBER_EVENTS];
+    if (emGetMemberEvents(em, member_id, -1, event_ids, MAX_MEMBER_EVENTS) != amount) {
+        return false;
+    }
+    return amount == 0 || memcmp(event_ids, expected_ids, amount * sizeof(*event_ids)) == 0;
+}
 
 
 /* ===== TESTING createEventManager ===== */
@@ -305,6 +314,34 @@ bool testEMAddEventByDiffBasicParameterErrors() {
     return result;
 }
 
+bool testEMAddEventByDiffLargeDays() {
+    bool result = true;
+    EventManager em = createEM(1, 1, 2000);
+    EventManager early_em = createEM(1, 1, -5000000);
+    Date date = dateCreate(1, 1, 2000);
+    ASSERT(em != NULL && early_em != NULL && date != NULL);
+
+    // there is no legal date that many days after 1.1.2000
+    ASSERT(emAddEventByDiff(em, "event1", INT_MAX - 100, 1) == EM_INVALID_DATE);
+    ASSERT(emAddEventByDiff(em, "event1", INT_MAX, 1) == EM_INVALID_DATE);
+    ASSERT(emAddEventByDiff(em, "event1", DATE_VALUE_MAX - dateSerial(date) + 1, 1) == EM_INVALID_DATE);
+    ASSERT(emGetEventsAmount(em) == 0);
+    ASSERT(emAddEventByDiff(em, "last", DATE_VALUE_MAX - dateSerial(date), 1) == EM_SUCCESS);
+    ASSERT(strcmp(emGetNextEvent(em), "last") == 0);
+
+    // but there is one for an earlier start
+    ASSERT(emAddEventByDiff(early_em, "event1", INT_MAX - 100, 1) == EM_SUCCESS);
+    ASSERT(emAddEventByDiff(early_em, "event2", INT_MAX, 2) == EM_SUCCESS);
+    ASSERT(emGetEventsAmount(early_em) == 2);
+    ASSERT(strcmp(emGetNextEvent(early_em), "event1") == 0);
+
+    destroy:
+    dateDestroy(date);
+    destroyEventManager(em);
+    destroyEventManager(early_em);
+    return result;
+}
+
 /* ========== TESTING emRemoveEvent ========== */
 bool testEMRemoveEventBasicErrors() {
     bool result = true;
@@ -536,6 +573,123 @@ bool testEMAddMemberBasicErrors() {
 
 
 
+/* ===== TESTING emRemoveMember ===== */
+/**
+ * Creates a manager with the members a, b, c, d with the IDs 1 to 4 and the events
+ * event1: a, b, c | event2: a, c | event3: b, d
+ */
+EventManager createLinkedEM() {
+    EventManager em = createEM(1, 1, 2000);
+    if (!em) {
+        return NULL;
+    }
+    emAddMember(em, "a", 1);
+    emAddMember(em, "b", 2);
+    emAddMember(em, "c", 3);
+    emAddMember(em, "d", 4);
+    emAddEventByDiff(em, "event1", 1, 1);
+    emAddEventByDiff(em, "event2", 2, 2);
+    emAddEventByDiff(em, "event3", 3, 3);
+    emAddMemberToEvent(em, 1, 1);
+    emAddMemberToEvent(em, 2, 1);
+    emAddMemberToEvent(em, 3, 1);
+    emAddMemberToEvent(em, 1, 2);
+    emAddMemberToEvent(em, 3, 2);
+    emAddMemberToEvent(em, 2, 3);
+    emAddMemberToEvent(em, 4, 3);
+    return em;
+}
+
+bool testEMRemoveMemberUnlinksFromEvents() {
+    bool result = true;
+    EventManager em = createLinkedEM();
+    int event_ids[MAX_MEMBER_EVENTS];
+    ASSERT(em != NULL);
+
+    ASSERT(emRemoveMember(NULL, 1) == EM_NULL_ARGUMENT);
+    ASSERT(emRemoveMember(em, -1) == EM_INVALID_MEMBER_ID);
+    ASSERT(emRemoveMember(em, 5) == EM_MEMBER_ID_NOT_EXISTS);
+
+    ASSERT(emRemoveMember(em, 1) == EM_SUCCESS);
+    ASSERT(emRemoveMember(em, 1) == EM_MEMBER_ID_NOT_EXISTS);
+    emPrintAllEvents(em, "remove_member_events.out.txt");
+    ASSERT(isFilePrintOutputCorrect("remove_member_events.out.txt",
+                                    "event1,2.1.2000,b,c\nevent2,3.1.2000,c\nevent3,4.1.2000,b,d\n"));
+    emPrintAllResponsibleMembers(em, "remove_member_members.out.txt");
+    ASSERT(isFilePrintOutputCorrect("remove_member_members.out.txt", "b,2\nc,2\nd,1\n"));
+
+    // a member added again with the ID of a removed one attends none of its events
+    ASSERT(emAddMember(em, "a", 1) == EM_SUCCESS);
+    ASSERT(emGetMemberEvents(em, 1, -1, event_ids, MAX_MEMBER_EVENTS) == 0);
+    ASSERT(emRemoveMemberFromEvent(em, 1, 1) == EM_EVENT_AND_MEMBER_NOT_LINKED);
+
+    destroy:
+    destroyEventManager(em);
+    return result;
+}
+
+bool testEMRemoveMembersAllOrNone() {
+    bool result = true;
+    EventManager em = createLinkedEM();
+    const int unknown_last[] = {2, 3, 9};
+    const int negative_last[] = {2, 3, -1};
+    const int negative_after_unknown[] = {9, -1};
+    char *all_events = "event1,2.1.2000,a,b,c\nevent2,3.1.2000,a,c\nevent3,4.1.2000,b,d\n";
+    char *all_members = "a,2\nb,2\nc,2\nd,1\n";
+    ASSERT(em != NULL);
+
+    ASSERT(emRemoveMembers(NULL, unknown_last, 3) == EM_NULL_ARGUMENT);
+    ASSERT(emRemoveMembers(em, NULL, 1) == EM_NULL_ARGUMENT);
+    ASSERT(emRemoveMembers(em, unknown_last, 3) == EM_MEMBER_ID_NOT_EXISTS);
+    ASSERT(emRemoveMembers(em, negative_last, 3) == EM_INVALID_MEMBER_ID);
+    // the IDs are checked in order and the first error is returned
+    ASSERT(emRemoveMembers(em, negative_after_unknown, 2) == EM_MEMBER_ID_NOT_EXISTS);
+
+    // nothing was removed by the failed calls
+    ASSERT(emCountMembersInNoEvent(em, NULL, 0) == 4);
+    emPrintAllEvents(em, "remove_members_none_events.out.txt");
+    ASSERT(isFilePrintOutputCorrect("remove_members_none_events.out.txt", all_events));
+    emPrintAllResponsibleMembers(em, "remove_members_none_members.out.txt");
+    ASSERT(isFilePrintOutputCorrect("remove_members_none_members.out.txt", all_members));
+
+    // no members at all removes nothing
+    ASSERT(emRemoveMembers(em, NULL, 0) == EM_SUCCESS);
+    ASSERT(emRemoveMembers(em, unknown_last, 0) == EM_SUCCESS);
+    ASSERT(emCountMembersInNoEvent(em, NULL, 0) == 4);
+
+    destroy:
+    destroyEventManager(em);
+    return result;
+}
+
+bool testEMRemoveMembersUnlinksFromEvents() {
+    bool result = true;
+    EventManager em = createLinkedEM();
+    const int with_duplicates[] = {2, 3, 2, 3, 3};
+    const int removed[] = {2};
+    ASSERT(em != NULL);
+
+    // a member listed more than once is removed once
+    ASSERT(emRemoveMembers(em, with_duplicates, 5) == EM_SUCCESS);
+    ASSERT(emCountMembersInNoEvent(em, NULL, 0) == 2);
+    emPrintAllEvents(em, "remove_members_events.out.txt");
+    ASSERT(isFilePrintOutputCorrect("remove_members_events.out.txt",
+                                    "event1,2.1.2000,a\nevent2,3.1.2000,a\nevent3,4.1.2000,d\n"));
+    emPrintAllResponsibleMembers(em, "remove_members_members.out.txt");
+    ASSERT(isFilePrintOutputCorrect("remove_members_members.out.txt", "a,2\nd,1\n"));
+
+    ASSERT(emRemoveMembers(em, removed, 1) == EM_MEMBER_ID_NOT_EXISTS);
+    ASSERT(emRemoveMemberFromEvent(em, 2, 3) == EM_MEMBER_ID_NOT_EXISTS);
+    ASSERT(emAddMemberToEvent(em, 2, 3) == EM_MEMBER_ID_NOT_EXISTS);
+
+    destroy:
+    destroyEventManager(em);
+    return result;
+}
+
+
+
+
 /* ===== TESTING emAddMemberToEvent ===== */
 
 bool testEMAddMemberToEventBasicParameterErrors() {
@@ -704,7 +858,73 @@ bool testEMTickDeletesPastEvents() {
     return result;
 }
 
-// TODO: add test that emTick does -1 to the event counter of members in deleted events
+bool testEMTickLargeDays() {
+    bool result = true;
+    EventManager em = createEM(1, 1, -5000000);
+    ASSERT(em != NULL);
+
+    ASSERT(emAddEventByDiff(em, "event1", INT_MAX - 100, 1) == EM_SUCCESS);
+    ASSERT(emAddEventByDiff(em, "event2", INT_MAX, 2) == EM_SUCCESS);
+    ASSERT(emAddMember(em, "member1", 1) == EM_SUCCESS);
+    ASSERT(emAddMemberToEvent(em, 1, 1) == EM_SUCCESS);
+
+    ASSERT(emTick(em, INT_MAX - 101) == EM_SUCCESS);
+    ASSERT(emGetEventsAmount(em) == 2);
+    ASSERT(emTick(em, 1) == EM_SUCCESS);
+    ASSERT(emGetEventsAmount(em) == 2);
+    ASSERT(emTick(em, 1) == EM_SUCCESS);
+    ASSERT(emGetEventsAmount(em) == 1);
+    ASSERT(strcmp(emGetNextEvent(em), "event2") == 0);
+    ASSERT(emCountMembersInNoEvent(em, NULL, 0) == 1);
+
+    // the clock stops at the last legal date, which is after every event
+    ASSERT(emTick(em, INT_MAX) == EM_SUCCESS);
+    ASSERT(emGetEventsAmount(em) == 0);
+    ASSERT(emTick(em, INT_MAX) == EM_SUCCESS);
+    ASSERT(emAddEventByDiff(em, "last", 0, 3) == EM_SUCCESS);
+    ASSERT(emAddEventByDiff(em, "after last", 1, 4) == EM_INVALID_DATE);
+    ASSERT(emTick(em, 1) == EM_SUCCESS);
+    ASSERT(emGetEventsAmount(em) == 1);
+
+    destroy:
+    destroyEventManager(em);
+    return result;
+}
+
+bool testEMTickReleasesMembers() {
+    bool result = true;
+    EventManager em = createEM(1, 1, 2000);
+    const int later_event[] = {3};
+
+    ASSERT(emAddMember(em, "member1", 1) == EM_SUCCESS);
+    ASSERT(emAddMember(em, "member2", 2) == EM_SUCCESS);
+    ASSERT(emAddEventByDiff(em, "event1", 1, 1) == EM_SUCCESS);
+    ASSERT(emAddEventByDiff(em, "event2", 1, 2) == EM_SUCCESS);
+    ASSERT(emAddEventByDiff(em, "event3", 3, 3) == EM_SUCCESS);
+    ASSERT(emAddMemberToEvent(em, 1, 1) == EM_SUCCESS);
+    ASSERT(emAddMemberToEvent(em, 1, 2) == EM_SUCCESS);
+    ASSERT(emAddMemberToEvent(em, 2, 2) == EM_SUCCESS);
+    ASSERT(emAddMemberToEvent(em, 2, 3) == EM_SUCCESS);
+    emPrintAllResponsibleMembers(em, "tick_release_members1.out.txt");
+    ASSERT(isFilePrintOutputCorrect("tick_release_members1.out.txt", "member1,2\nmember2,2\n"));
+
+    // both members lose the two past events, member2 keeps the later one
+    ASSERT(emTick(em, 2) == EM_SUCCESS);
+    ASSERT(emGetEventsAmount(em) == 1);
+    emPrintAllResponsibleMembers(em, "tick_release_members2.out.txt");
+    ASSERT(isFilePrintOutputCorrect("tick_release_members2.out.txt", "member2,1\n"));
+    ASSERT(memberEventsAre(em, 1, NULL, 0));
+    ASSERT(memberEventsAre(em, 2, later_event, 1));
+
+    ASSERT(emTick(em, 2) == EM_SUCCESS);
+    emPrintAllResponsibleMembers(em, "tick_release_members3.out.txt");
+    ASSERT(isFilePrintOutputCorrect("tick_release_members3.out.txt", ""));
+    ASSERT(memberEventsAre(em, 2, NULL, 0));
+
+    destroy:
+    destroyEventManager(em);
+    return result;
+}
 
 
 /* ========== TESTING emGetEventsAmount ========== */
@@ -872,6 +1092,288 @@ bool testEMPrintAllEventsBasicTests() {
 }
 
 
+/* ========== TESTING emGetMemberEvents ========== */
+bool testEMGetMemberEventsBasicErrors() {
+    bool result = true;
+    EventManager em = createEM(1, 1, 2000);
+    int event_ids[MAX_MEMBER_EVENTS];
+
+    ASSERT(emAddMember(em, "member1", 1) == EM_SUCCESS);
+    ASSERT(emAddEventByDiff(em, "event1", 1, 1) == EM_SUCCESS);
+    ASSERT(emGetMemberEvents(NULL, 1, -1, event_ids, MAX_MEMBER_EVENTS) == -1);
+    ASSERT(emGetMemberEvents(em, 1, -1, NULL, MAX_MEMBER_EVENTS) == -1);
+    ASSERT(emGetMemberEvents(em, 1, -1, event_ids, -1) == -1);
+    ASSERT(emGetMemberEvents(em, 2, -1, event_ids, MAX_MEMBER_EVENTS) == -1);
+    ASSERT(emGetMemberEvents(em, -1, -1, event_ids, MAX_MEMBER_EVENTS) == -1);
+
+    // a member that never attended an event has none, as does one that left all of them
+    ASSERT(emGetMemberEvents(em, 1, -1, event_ids, MAX_MEMBER_EVENTS) == 0);
+    ASSERT(emAddMemberToEvent(em, 1, 1) == EM_SUCCESS);
+    ASSERT(emGetMemberEvents(em, 1, -1, event_ids, 0) == 0);
+    ASSERT(emRemoveMemberFromEvent(em, 1, 1) == EM_SUCCESS);
+    ASSERT(emGetMemberEvents(em, 1, -1, event_ids, MAX_MEMBER_EVENTS) == 0);
+    ASSERT(emRemoveMemberFromEvent(em, 1, 1) == EM_EVENT_AND_MEMBER_NOT_LINKED);
+
+    destroy:
+    destroyEventManager(em);
+    return result;
+}
+
+bool testEMGetMemberEventsFollowsRemovals() {
+    bool result = true;
+    EventManager em = createEM(1, 1, 2000);
+    const int all_events[] = {1, 2, 3, 4, 5};
+    const int without_left[] = {1, 2, 4, 5};
+    const int without_removed[] = {1, 2, 5};
+    const int without_past[] = {5};
+    const int second_member[] = {2, 4, 5};
+    const int second_without_removed[] = {2, 5};
+
+    ASSERT(emAddMember(em, "member1", 1) == EM_SUCCESS);
+    ASSERT(emAddMember(em, "member2", 2) == EM_SUCCESS);
+    for (int event_id = 1; event_id <= 5; event_id++) {
+        ASSERT(emAddEventByDiff(em, "event", event_id, event_id) == EM_SUCCESS);
+        ASSERT(emAddMemberToEvent(em, 1, event_id) == EM_SUCCESS);
+    }
+    ASSERT(emAddMemberToEvent(em, 2, 2) == EM_SUCCESS);
+    ASSERT(emAddMemberToEvent(em, 2, 4) == EM_SUCCESS);
+    ASSERT(emAddMemberToEvent(em, 2, 5) == EM_SUCCESS);
+    ASSERT(memberEventsAre(em, 1, all_events, 5));
+    ASSERT(memberEventsAre(em, 2, second_member, 3));
+
+    ASSERT(emRemoveMemberFromEvent(em, 1, 3) == EM_SUCCESS);
+    ASSERT(memberEventsAre(em, 1, without_left, 4));
+    ASSERT(memberEventsAre(em, 2, second_member, 3));
+
+    ASSERT(emRemoveEvent(em, 4) == EM_SUCCESS);
+    ASSERT(memberEventsAre(em, 1, without_removed, 3));
+    ASSERT(memberEventsAre(em, 2, second_without_removed, 2));
+
+    // the events of the first two days are past after three days
+    ASSERT(emTick(em, 3) == EM_SUCCESS);
+    ASSERT(emGetEventsAmount(em) == 2);
+    ASSERT(memberEventsAre(em, 1, without_past, 1));
+    ASSERT(memberEventsAre(em, 2, without_past, 1));
+
+    // an event added again with a removed ID starts without the members of the old one
+    ASSERT(emAddEventByDiff(em, "event", 6, 4) == EM_SUCCESS);
+    ASSERT(memberEventsAre(em, 1, without_past, 1));
+    ASSERT(emAddMemberToEvent(em, 1, 4) == EM_SUCCESS);
+    ASSERT(emRemoveEvent(em, 5) == EM_SUCCESS);
+    ASSERT(memberEventsAre(em, 2, NULL, 0));
+    ASSERT(emRemoveEvent(em, 4) == EM_SUCCESS);
+    ASSERT(memberEventsAre(em, 1, NULL, 0));
+
+    destroy:
+    destroyEventManager(em);
+    return result;
+}
+
+bool testEMGetMemberEventsPaging() {
+    bool result = true;
+    EventManager em = createEM(1, 1, 2000);
+    int event_ids[MAX_MEMBER_EVENTS];
+    int page_size = 4;
+
+    ASSERT(emAddMember(em, "member1", 1) == EM_SUCCESS);
+    for (int i = 0; i < 10; i++) {
+        ASSERT(emAddEventByDiff(em, "event", i + 1, 3 * i) == EM_SUCCESS);
+        ASSERT(emAddMemberToEvent(em, 1, 3 * i) == EM_SUCCESS);
+    }
+
+    // each page continues after the last ID of the previous one, a short page is the last
+    int cursor = -1;
+    int copied = 0;
+    int amount;
+    do {
+        amount = emGetMemberEvents(em, 1, cursor, event_ids + copied, page_size);
+        ASSERT(amount >= 0 && amount <= page_size && copied + amount <= 10);
+        copied += amount;
+        cursor = copied > 0 ? event_ids[copied - 1] : cursor;
+    } while (amount == page_size);
+    ASSERT(copied == 10);
+    for (int i = 0; i < 10; i++) {
+        ASSERT(event_ids[i] == 3 * i);
+    }
+
+    // a cursor between IDs starts at the next one
+    ASSERT(emGetMemberEvents(em, 1, 10, event_ids, page_size) == page_size);
+    ASSERT(event_ids[0] == 12 && event_ids[3] == 21);
+    ASSERT(emGetMemberEvents(em, 1, 26, event_ids, page_size) == 1 && event_ids[0] == 27);
+    ASSERT(emGetMemberEvents(em, 1, 27, event_ids, page_size) == 0);
+
+    destroy:
+    destroyEventManager(em);
+    return result;
+}
+
+
+/* ========== TESTING emCountMembers ========== */
+/**
+ * Creates a manager with the members 1 to 7 and the events
+ * 1: members 1, 2, 3, 4 | 2: members 3, 4, 5 | 3: members 4, 6 | 4: no members
+ */
+EventManager createCountingEM() {
+    const int event_members[][4] = {{1, 2, 3, 4}, {3, 4, 5}, {4, 6}, {0}};
+    EventManager em = createEM(1, 1, 2000);
+    if (!em) {
+        return NULL;
+    }
+    for (int member_id = 1; member_id <= 7; member_id++) {
+        emAddMember(em, "member", member_id);
+    }
+    for (int event_id = 1; event_id <= 4; event_id++) {
+        emAddEventByDiff(em, "event", event_id, event_id);
+        for (int i = 0; i < 4 && event_members[event_id - 1][i] != 0; i++) {
+            emAddMemberToEvent(em, event_members[event_id - 1][i], event_id);
+        }
+    }
+    return em;
+}
+
+bool testEMCountMembersInAllEvents() {
+    bool result = true;
+    EventManager em = createCountingEM();
+    const int one[] = {1};
+    const int two[] = {1, 2};
+    const int three[] = {1, 2, 3};
+    const int with_empty[] = {1, 4};
+    const int repeated[] = {1, 1};
+    ASSERT(em != NULL);
+
+    ASSERT(emCountMembersInAllEvents(NULL, one, 1) == -1);
+    ASSERT(emCountMembersInAllEvents(em, NULL, 1) == -1);
+    ASSERT(emCountMembersInAllEvents(em, one, 0) == -1);
+    ASSERT(emCountMembersInAllEvents(em, one, 1) == 4);
+    ASSERT(emCountMembersInAllEvents(em, two, 2) == 2);
+    ASSERT(emCountMembersInAllEvents(em, three, 3) == 1);
+    ASSERT(emCountMembersInAllEvents(em, with_empty, 2) == 0);
+    ASSERT(emCountMembersInAllEvents(em, repeated, 2) == 4);
+
+    destroy:
+    destroyEventManager(em);
+    return result;
+}
+
+bool testEMCountMembersInAnyEvent() {
+    bool result = true;
+    EventManager em = createCountingEM();
+    const int one[] = {1};
+    const int two[] = {1, 2};
+    const int three[] = {1, 2, 3};
+    const int only_empty[] = {4};
+    const int repeated[] = {2, 2, 2};
+    ASSERT(em != NULL);
+
+    ASSERT(emCountMembersInAnyEvent(NULL, one, 1) == -1);
+    ASSERT(emCountMembersInAnyEvent(em, NULL, 1) == -1);
+    ASSERT(emCountMembersInAnyEvent(em, one, -1) == -1);
+    ASSERT(emCountMembersInAnyEvent(em, NULL, 0) == 0);
+    ASSERT(emCountMembersInAnyEvent(em, one, 1) == 4);
+    ASSERT(emCountMembersInAnyEvent(em, two, 2) == 5);
+    ASSERT(emCountMembersInAnyEvent(em, three, 3) == 6);
+    ASSERT(emCountMembersInAnyEvent(em, only_empty, 1) == 0);
+    ASSERT(emCountMembersInAnyEvent(em, repeated, 3) == 3);
+
+    destroy:
+    destroyEventManager(em);
+    return result;
+}
+
+bool testEMCountMembersInNoEvent() {
+    bool result = true;
+    EventManager em = createCountingEM();
+    const int one[] = {1};
+    const int two[] = {1, 2};
+    const int three[] = {1, 2, 3};
+    const int only_empty[] = {4};
+    ASSERT(em != NULL);
+
+    ASSERT(emCountMembersInNoEvent(NULL, one, 1) == -1);
+    ASSERT(emCountMembersInNoEvent(em, NULL, 1) == -1);
+    ASSERT(emCountMembersInNoEvent(em, one, -1) == -1);
+    ASSERT(emCountMembersInNoEvent(em, NULL, 0) == 7);
+    ASSERT(emCountMembersInNoEvent(em, one, 1) == 3);
+    ASSERT(emCountMembersInNoEvent(em, two, 2) == 2);
+    ASSERT(emCountMembersInNoEvent(em, three, 3) == 1);
+    ASSERT(emCountMembersInNoEvent(em, only_empty, 1) == 7);
+
+    // members added later are in none of the events until they are linked
+    ASSERT(emAddMember(em, "late", 8) == EM_SUCCESS);
+    ASSERT(emCountMembersInNoEvent(em, three, 3) == 2);
+    ASSERT(emAddMemberToEvent(em, 8, 3) == EM_SUCCESS);
+    ASSERT(emCountMembersInNoEvent(em, three, 3) == 1);
+
+    destroy:
+    destroyEventManager(em);
+    return result;
+}
+
+bool testEMCountMembersOnlyInEvent() {
+    bool result = true;
+    EventManager em = createCountingEM();
+    const int first[] = {1};
+    const int second[] = {2};
+    const int first_and_third[] = {1, 3};
+    const int second_and_third[] = {2, 3};
+    ASSERT(em != NULL);
+
+    ASSERT(emCountMembersOnlyInEvent(NULL, 1, second, 1) == -1);
+    ASSERT(emCountMembersOnlyInEvent(em, 1, NULL, 1) == -1);
+    ASSERT(emCountMembersOnlyInEvent(em, 1, second, -1) == -1);
+    ASSERT(emCountMembersOnlyInEvent(em, 1, NULL, 0) == 4);
+    ASSERT(emCountMembersOnlyInEvent(em, 1, second, 1) == 2);
+    ASSERT(emCountMembersOnlyInEvent(em, 3, first, 1) == 1);
+    ASSERT(emCountMembersOnlyInEvent(em, 1, second_and_third, 2) == 2);
+    ASSERT(emCountMembersOnlyInEvent(em, 2, first_and_third, 2) == 1);
+    ASSERT(emCountMembersOnlyInEvent(em, 4, first, 1) == 0);
+    ASSERT(emCountMembersOnlyInEvent(em, 1, first, 1) == 0);
+
+    destroy:
+    destroyEventManager(em);
+    return result;
+}
+
+bool testEMCountMembersOfMissingEvent() {
+    bool result = true;
+    EventManager em = createCountingEM();
+    const int missing[] = {9};
+    const int first_missing[] = {9, 1};
+    const int second_missing[] = {1, 9};
+    const int third_missing[] = {1, 2, 9};
+    ASSERT(em != NULL);
+
+    // two events are counted without combining their sets, any other amount combines them
+    ASSERT(emCountMembersInAllEvents(em, missing, 1) == -1);
+    ASSERT(emCountMembersInAllEvents(em, first_missing, 2) == -1);
+    ASSERT(emCountMembersInAllEvents(em, second_missing, 2) == -1);
+    ASSERT(emCountMembersInAllEvents(em, third_missing, 3) == -1);
+    ASSERT(emCountMembersInAnyEvent(em, missing, 1) == -1);
+    ASSERT(emCountMembersInAnyEvent(em, first_missing, 2) == -1);
+    ASSERT(emCountMembersInAnyEvent(em, second_missing, 2) == -1);
+    ASSERT(emCountMembersInAnyEvent(em, third_missing, 3) == -1);
+    ASSERT(emCountMembersInNoEvent(em, missing, 1) == -1);
+    ASSERT(emCountMembersInNoEvent(em, second_missing, 2) == -1);
+    ASSERT(emCountMembersInNoEvent(em, third_missing, 3) == -1);
+
+    // one other event is counted without combining the sets
+    ASSERT(emCountMembersOnlyInEvent(em, 9, second_missing, 1) == -1);
+    ASSERT(emCountMembersOnlyInEvent(em, 1, missing, 1) == -1);
+    ASSERT(emCountMembersOnlyInEvent(em, 9, NULL, 0) == -1);
+    ASSERT(emCountMembersOnlyInEvent(em, 1, third_missing + 1, 2) == -1);
+    ASSERT(emCountMembersOnlyInEvent(em, 9, third_missing, 2) == -1);
+
+    // a removed event is missing as well
+    ASSERT(emRemoveEvent(em, 2) == EM_SUCCESS);
+    ASSERT(emCountMembersInAllEvents(em, third_missing, 2) == -1);
+    ASSERT(emCountMembersOnlyInEvent(em, 1, third_missing + 1, 1) == -1);
+
+    destroy:
+    destroyEventManager(em);
+    return result;
+}
+
+
 /* ========== Tests from more people ========== */
 
 bool testBigEventManager_CreatorYanTomsinsky() {
@@ -1293,6 +1795,7 @@ bool testNegativeYearTwo_CreatorAdam() {
     X(testEmAddEventByDiffDateTickUsage) \
     X(testEMAddEventByDiffBasicUsage) \
     X(testEMAddEventByDiffBasicParameterErrors) \
+    X(testEMAddEventByDiffLargeDays) \
     X(testEMRemoveEventBasicErrors)\
     X(testEMRemoveEventDoesntFindByName) \
     X(testEMRemoveEventFindsEventFromAddByDiffAndAddByDate) \
@@ -1302,18 +1805,31 @@ bool testNegativeYearTwo_CreatorAdam() {
     X(testEMChangeEventDateReinsertsTheEvent) \
     X(testEMAddMemberBasicUsage) \
     X(testEMAddMemberBasicErrors) \
+    X(testEMRemoveMemberUnlinksFromEvents) \
+    X(testEMRemoveMembersAllOrNone) \
+    X(testEMRemoveMembersUnlinksFromEvents) \
     X(testEMAddMemberToEventBasicParameterErrors) \
     X(testEMAddMemberToEventBasicUsage) \
     X(testEMRemoveMemberFromEventBasicErrors) \
     X(testEMRemoveMemberFromEventBasicUsage) \
     X(testEMTickBasicErrors) \
     X(testEMTickDeletesPastEvents) \
+    X(testEMTickLargeDays) \
+    X(testEMTickReleasesMembers) \
     X(testEMGetEventsAmountBasicErrors) \
     X(testEMGetEventsAmountBasicUsage) \
     X(testEMGetNextEventBasicErrors) \
     X(testEMGetNextEventGetsEventInCorrectOrder) \
     X(testEMPrintAllResponsibleMembersSimpleTests) \
     X(testEMPrintAllEventsBasicTests) \
+    X(testEMGetMemberEventsBasicErrors) \
+    X(testEMGetMemberEventsFollowsRemovals) \
+    X(testEMGetMemberEventsPaging) \
+    X(testEMCountMembersInAllEvents) \
+    X(testEMCountMembersInAnyEvent) \
+    X(testEMCountMembersInNoEvent) \
+    X(testEMCountMembersOnlyInEvent) \
+    X(testEMCountMembersOfMissingEvent) \
     X(testBigEventManager_CreatorYanTomsinsky) \
     X(testChangeDate_CreatorAdar) \
     X(testRemoveEventsAndMembers_CreatorAdar) \
@@ -1334,7 +1850,7 @@ const char *testNames[] = {
 #undef X
 };
 
-#define NUMBER_TESTS 37
+#define NUMBER_TESTS 51
 
 int main(int argc, char **argv) {
     if (argc == 1) {
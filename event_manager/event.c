@@ -1,5 +1,5 @@
 #include "event.h"
-#include "priority_queue.h"
+#include "intern.h"
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
@@ -11,103 +11,55 @@ struct Event_t
 {
     int id;
     char *name;
-    Date date;
-    PriorityQueue members;
+    unsigned int name_hash;
+    DateValue date;
+    AttendeeSet members;
+    int iterator;
 };
 
-static PQElement copyMemberGeneric(PQElement member)
+/** name must be an interned string, the new event takes a reference of its own to it */
+static Event eventCreateWithMembers(int id, char *name, DateValue date, AttendeeSet members)
 {
-    Member member_copy = memberCopy((Member)member);
-    return member_copy;
-}
-
-static void freeMemberGeneric(PQElement member)
-{
-    memberDestroy((Member)member);
-}
-
-static bool compareMembersGeneric(PQElement member1, PQElement member2)
-{
-    return memberCompare((Member)member1, (Member)member2);
-}
+    assert(name != NULL && date != DATE_VALUE_INVALID && members != NULL);
 
-static PQElementPriority copyIntGeneric(PQElementPriority n)
-{
-    if (!n)
-    {
-        return NULL;
-    }
-    int *copy = malloc(sizeof(*copy));
-    if (!copy)
+    Event event = malloc(sizeof(*event));
+    if (event == NULL)
     {
         return NULL;
     }
-    *copy = *(int *)n;
-    return copy;
-}
 
-static void freeIntGeneric(PQElementPriority n)
-{
-    free(n);
-}
+    event->id = id;
+    event->name = internRetain(name);
+    event->name_hash = internGetHash(name);
+    event->date = date;
+    event->members = members;
+    event->iterator = EVENT_NO_MEMBER;
 
-static int compareIntsGeneric(PQElementPriority n1, PQElementPriority n2)
-{
-    return (*(int *)n2 - *(int *)n1);
+    return event;
 }
 
-static char *copyString(char *string)
+Event eventCreate(int id, char *name, DateValue date)
 {
-    char *new_string = malloc(strlen(string) + 1);
-    if (new_string == NULL)
+    if (name == NULL || date == DATE_VALUE_INVALID)
     {
         return NULL;
     }
-    strcpy(new_string, string);
-    return new_string;
-}
 
-Event eventCreate(int id, char *name, Date date)
-{
-    if (name == NULL || date == NULL)
+    AttendeeSet members = attendeeSetCreate();
+    if (members == NULL)
     {
         return NULL;
     }
 
-    Event event = malloc(sizeof(*event));
+    char *interned_name = internString(name);
+    Event event = interned_name ? eventCreateWithMembers(id, interned_name, date, members) : NULL;
+    internRelease(interned_name);
     if (event == NULL)
     {
+        attendeeSetDestroy(members);
         return NULL;
     }
 
-    event->members = pqCreate(copyMemberGeneric, freeMemberGeneric, compareMembersGeneric,
-                              copyIntGeneric, freeIntGeneric, compareIntsGeneric);
-    if (event->members == NULL)
-    {
-        return NULL;
-    }
-
-    char *new_name = copyString(name);
-    if (new_name == NULL)
-    {
-        pqDestroy(event->members);
-        free(event);
-        return NULL;
-    }
-
-    Date new_date = dateCopy(date);
-    if (new_date == NULL)
-    {
-        pqDestroy(event->members);
-        free(new_name);
-        free(event);
-        return NULL;
-    }
-
-    event->id = id;
-    event->name = new_name;
-    event->date = new_date;
-
     return event;
 }
 
@@ -118,9 +70,8 @@ void eventDestroy(Event event)
         return;
     }
 
-    dateDestroy(event->date);
-    pqDestroy(event->members);
-    free(event->name);
+    attendeeSetDestroy(event->members);
+    internRelease(event->name);
     free(event);
 }
 
@@ -131,22 +82,19 @@ Event eventCopy(Event event)
         return NULL;
     }
 
-    Event new_event = eventCreate(event->id, event->name, event->date);
-
-    if (new_event == NULL)
+    AttendeeSet new_members = attendeeSetCopy(event->members);
+    if (new_members == NULL)
     {
         return NULL;
     }
 
-    PriorityQueue new_pq = pqCopy(event->members);
-    if (new_pq == NULL)
+    Event new_event = eventCreateWithMembers(event->id, event->name, event->date, new_members);
+    if (new_event == NULL)
     {
+        attendeeSetDestroy(new_members);
         return NULL;
     }
 
-    pqDestroy(new_event->members);
-    new_event->members = new_pq;
-
     return new_event;
 }
 
@@ -168,15 +116,24 @@ int eventGetId(Event event)
     return event->id;
 }
 
-Date eventGetDate(Event event)
+DateValue eventGetDate(Event event)
 {
     if (event == NULL)
     {
-        return NULL;
+        return DATE_VALUE_INVALID;
     }
     return event->date;
 }
 
+unsigned int eventGetNameHash(Event event)
+{
+    if (event == NULL)
+    {
+        return 0;
+    }
+    return event->name_hash;
+}
+
 bool eventEquals(Event event1, Event event2)
 {
     if (event1 == NULL || event2 == NULL || event1->id != event2->id)
@@ -187,30 +144,34 @@ bool eventEquals(Event event1, Event event2)
     return true;
 }
 
-EventResult eventAddMember(Event event, Member member)
+EventResult eventAddMember(Event event, int member_id)
 {
-    if (event == NULL || member == NULL)
+    if (event == NULL)
     {
         return EVENT_NULL_ARGUMENT;
     }
 
-    int member_id = memberGetId(member);
-    if (pqInsert(event->members, member, &member_id) == PQ_OUT_OF_MEMORY)
+    switch (attendeeSetAdd(event->members, member_id))
     {
+    case ATTENDEE_SET_INVALID_ID:
+        return EVENT_INVALID_ID;
+    case ATTENDEE_SET_ID_ALREADY_EXISTS:
+        return EVENT_MEMBER_ALREADY_EXISTS;
+    case ATTENDEE_SET_OUT_OF_MEMORY:
         return EVENT_OUT_OF_MEMORY;
+    default:
+        return EVENT_SUCCESS;
     }
-
-    return EVENT_SUCCESS;
 }
 
-EventResult eventRemoveMember(Event event, Member member)
+EventResult eventRemoveMember(Event event, int member_id)
 {
-    if (event == NULL || member == NULL)
+    if (event == NULL)
     {
         return EVENT_NULL_ARGUMENT;
     }
 
-    if (pqRemoveElement(event->members, member) == PQ_ELEMENT_DOES_NOT_EXISTS)
+    if (attendeeSetRemove(event->members, member_id) == ATTENDEE_SET_ID_DOES_NOT_EXIST)
     {
         return EVENT_MEMBER_DOES_NOT_EXIST;
     }
@@ -218,51 +179,80 @@ EventResult eventRemoveMember(Event event, Member member)
     return EVENT_SUCCESS;
 }
 
-EventResult eventChangeDate(Event event, Date date)
+bool eventHasMember(Event event, int member_id)
 {
-    if (event == NULL || date == NULL)
+    if (event == NULL)
     {
-        return EVENT_NULL_ARGUMENT;
+        return false;
     }
+    return attendeeSetContains(event->members, member_id);
+}
 
-    Date new_date = dateCopy(date);
-    if (new_date == NULL)
+int eventGetMembersAmount(Event event)
+{
+    if (event == NULL)
     {
-        return EVENT_OUT_OF_MEMORY;
+        return -1;
+    }
+    return attendeeSetGetSize(event->members);
+}
+
+AttendeeSet eventGetMembers(Event event)
+{
+    if (event == NULL)
+    {
+        return NULL;
+    }
+    return event->members;
+}
+
+EventResult eventChangeDate(Event event, DateValue date)
+{
+    if (event == NULL || date == DATE_VALUE_INVALID)
+    {
+        return EVENT_NULL_ARGUMENT;
     }
 
-    dateDestroy(event->date);
-    event->date = new_date;
+    event->date = date;
     return EVENT_SUCCESS;
 }
 
-void eventPrint(Event event, FILE *file)
+void eventPrint(Event event, FILE *file, EventMemberName member_name, void *context)
 {
-    int day, month, year;
-    dateGet(event->date, &day, &month, &year);
-    fprintf(file, "%s,%d.%d.%d", event->name, day, month, year);
-    PQ_FOREACH(Member, iterator, event->members)
+    char date[DATE_FORMAT_BUFFER_SIZE];
+    dateValueFormat(event->date, date);
+    fputs(event->name, file);
+    fputc(',', file);
+    fputs(date, file);
+    ATTENDEE_SET_FOREACH(member_id, event->members)
     {
-        fprintf(file, ",%s", memberGetName(iterator));
+        char *name = member_name(member_id, context);
+        if (name != NULL)
+        {
+            fputc(',', file);
+            fputs(name, file);
+        }
     }
 }
 
-Member eventGetFirst(Event event)
+int eventGetFirst(Event event)
 {
     if (event == NULL)
     {
-        return NULL;
+        return EVENT_NO_MEMBER;
     }
 
-    return pqGetFirst(event->members);
+    event->iterator = attendeeSetGetFirst(event->members);
+    return event->iterator;
 }
 
-Member eventGetNext(Event event)
+int eventGetNext(Event event)
 {
-    if (event == NULL)
+    if (event == NULL || event->iterator == EVENT_NO_MEMBER)
     {
-        return NULL;
+        return EVENT_NO_MEMBER;
     }
 
-    return pqGetNext(event->members);
-}
\ No newline at end of file
+    event->iterator = attendeeSetGetNext(event->members, event->iterator);
+    return event->iterator;
+}
@@ -2,13 +2,15 @@
 #define EVENT_H_
 
 #include <stdbool.h>
-#include "member.h"
+#include <stdio.h>
 #include "date.h"
+#include "attendee_set.h"
 
 /**
 * Event
 *
 * Implements an event type.
+* The event holds the ids of its members, not the members themselves, in ascending order.
 * The event has an internal iterator for iterating over it's members. For all functions
 * where the state of the iterator after calling that function is not stated,
 * it is undefined. That means that you cannot assume anything about it.
@@ -21,16 +23,20 @@
 *   eventGetName        - Returns the name of the event.
 *   eventGetId          - Returns the ID of the event.
 *   eventGetDate        - Returns the date of the event.
+*   eventGetNameHash    - Returns the hash of the name of the event.
 *   eventEquals         - Checks if two events are equals.
 *   eventAddMember      - add a member for the event.
 *                           Iterator's value is undefined after this operation.
 *   eventRemoveMember   - Removes the member from the event.
 *                           Iterator's value is undefined after this operation.
+*   eventHasMember      - Checks if a member is in the event.
+*   eventGetMembersAmount - Returns the number of members in the event.
+*   eventGetMembers     - Returns the set of the IDs of the members of the event.
 *   eventChangeDate     - Changes the event's date.
 *   eventPrint          - Prints the details of the event.
 *   eventGetFirst       - Sets the internal iterator to the first member in the event.
 *   eventGetNext        - Advances the event iterator to the next member and returns it.
-* 	PQ_FOREACH	        - A macro for iterating over the event's members.
+* 	EVENT_FOREACH	    - A macro for iterating over the event's members.
 */
 
 /** Type for defining the event */
@@ -48,18 +54,27 @@ typedef enum EventResult_t
     Event_ERROR
 } EventResult;
 
+/** Returned by eventGetFirst and eventGetNext when there is no member to return */
+#define EVENT_NO_MEMBER -1
+
+/**
+* Type of function used by eventPrint to find the name of a member by its id.
+* context is passed on from the caller. NULL means the member is not printed.
+*/
+typedef char *(*EventMemberName)(int member_id, void *context);
+
 /**
 * eventCreate: Allocates a new event.
 *
 * @param id - The ID number of the event.
 * @param name - The name of the event.
-* @param date - The date of the event.
+* @param date - The value of the date of the event.
 *
 * @return
-* 	NULL - if one of the parameters is NULL or allocations failed.
+* 	NULL - if name is NULL, date is DATE_VALUE_INVALID or allocations failed.
 * 	A new event in case of success.
 */
-Event eventCreate(int id, char *name, Date date);
+Event eventCreate(int id, char *name, DateValue date);
 
 /**
 * eventDestroy: Deallocates an existing event.
@@ -82,6 +97,7 @@ Event eventCopy(Event event);
 
 /**
 * eventGetName: Returns the name of the event.
+* Names are interned, the returned string is shared and must not be modified.
 * @param event - The event which name is requested.
 * @return
 * 	NULL if a NULL pointer was sent.
@@ -102,10 +118,20 @@ int eventGetId(Event event);
 * eventGetDate: Returns the date of the event.
 * @param event - The event which date is requested.
 * @return
-* 	NULL if a NULL pointer was sent.
-* 	Otherwise the date of the event.
+* 	DATE_VALUE_INVALID if a NULL pointer was sent.
+* 	Otherwise the value of the date of the event.
 */
-Date eventGetDate(Event event);
+DateValue eventGetDate(Event event);
+
+/**
+* eventGetNameHash: Returns the hash of the name of the event, computed once when the
+* event was created. Events with equal names have equal hashes.
+* @param event - The event which name hash is requested.
+* @return
+* 	0 if a NULL pointer was sent.
+* 	Otherwise the hash of the name of the event.
+*/
+unsigned int eventGetNameHash(Event event);
 
 /**
 * eventEquals: Checks if two events are equals.
@@ -120,52 +146,84 @@ Date eventGetDate(Event event);
 bool eventEquals(Event event1, Event event2);
 
 /**
-* eventAddMember: add a member for the event.
+* eventAddMember: add a member for the event, in O(log n).
 *   Iterator's value is undefined after this operation.
 *
 * @param event - The event for which to add the member.
-* @param member - The member which need to be added.
-*      A copy of the member will be inserted.
+* @param member_id - The ID of the member which need to be added.
 * @return
-* 	EVENT_NULL_ARGUMENT if a NULL was sent as one of the parameters.
+* 	EVENT_NULL_ARGUMENT if a NULL was sent as event.
+* 	EVENT_INVALID_ID if member_id is negative.
+* 	EVENT_MEMBER_ALREADY_EXISTS if the member is already in the event.
 * 	EVENT_OUT_OF_MEMORY if an allocation failed.
 * 	EVENT_SUCCESS the member had been added successfully.
 */
-EventResult eventAddMember(Event event, Member member);
+EventResult eventAddMember(Event event, int member_id);
 
 /**
 * eventRemoveMember: Removes the member from the event.
 *   Iterator's value is undefined after this operation.
 *
 * @param event - The event to remove the member from.
-* @param member - The member to find and remove from the event.
+* @param member_id - The ID of the member to find and remove from the event.
 * @return
 * 	EVENT_NULL_ARGUMENT if a NULL was sent to the function.
 * 	EVENT_MEMBER_DOES_NOT_EXIST if given member does not exists.
 * 	event_SUCCESS if the member had been removed successfully.
 */
-EventResult eventRemoveMember(Event event, Member member);
+EventResult eventRemoveMember(Event event, int member_id);
+
+/**
+* eventHasMember: Checks if a member is in the event, in O(log n).
+*
+* @param event - The event to search in.
+* @param member_id - The ID of the member to look for.
+* @return
+* 	false if a NULL was sent or the member is not in the event.
+* 	true otherwise.
+*/
+bool eventHasMember(Event event, int member_id);
+
+/**
+* eventGetMembersAmount: Returns the number of members in the event.
+* @param event - The event which number of members is requested.
+* @return
+* 	-1 if a NULL pointer was sent.
+* 	Otherwise the number of members in the event.
+*/
+int eventGetMembersAmount(Event event);
+
+/**
+* eventGetMembers: Returns the set of the IDs of the members of the event, for counting and
+* combining the members of several events.
+* @param event - The event which members are requested.
+* @return
+* 	NULL if a NULL pointer was sent.
+* 	Otherwise the set of the event, owned by the event. It must not be changed.
+*/
+AttendeeSet eventGetMembers(Event event);
 
 /**
 * eventChangeDate: Changes the event's date.
 *
 * @param event - The event which date should be changed.
-* @param date - The new date for the event.
+* @param date - The value of the new date for the event.
 *
 * @return
-* 	EVENT_NULL_ARGUMENT if a NULL was sent to the function.
-* 	EVENT_OUT_OF_MEMORY if an allocation failed.
+* 	EVENT_NULL_ARGUMENT if a NULL was sent to the function or date is DATE_VALUE_INVALID.
 * 	event_SUCCESS if the date has been changed successfully.
 */
-EventResult eventChangeDate(Event event, Date date);
+EventResult eventChangeDate(Event event, DateValue date);
 
 /**
 * eventPrint: Prints the details of the event.
 *
 * @param event - The event which details should be printed.
 * @param file - pointer to the output file.
+* @param member_name - Function returning the name of a member by its ID.
+* @param context - Passed on to member_name.
 */
-void eventPrint(Event event, FILE *file);
+void eventPrint(Event event, FILE *file, EventMemberName member_name, void *context);
 
 /**
 * eventGetFirst: Sets the internal iterator (also called current member) to
@@ -175,29 +233,29 @@ void eventPrint(Event event, FILE *file);
 *
 * @param event - The event for which to set the iterator and return the first member.
 * @return
-* 	NULL if a NULL pointer was sent or the event is empty.
-* 	The first member of the event otherwise.
+* 	EVENT_NO_MEMBER if a NULL pointer was sent or the event is empty.
+* 	The ID of the first member of the event otherwise.
 */
-Member eventGetFirst(Event event);
+int eventGetFirst(Event event);
 
 /**
 * eventGetNext: Advances the event iterator to the next member and returns it.
 *
 * @param event - The event for which to advance the iterator.
 * @return
-* 	NULL if reached the end of the event members, or the iterator is at an invalid state
-* 	or a NULL sent as argument.
-* 	The next member on the event in case of success.
+* 	EVENT_NO_MEMBER if reached the end of the event members, or the iterator is at an
+* 	invalid state or a NULL sent as argument.
+* 	The ID of the next member on the event in case of success.
 */
-Member eventGetNext(Event event);
+int eventGetNext(Event event);
 
 /*!
-* Macro for iterating over the event members.
-* Declares a new iterator for the loop.
+* Macro for iterating over the IDs of the event members.
+* Declares a new int iterator for the loop.
 */
-#define EVENT_FOREACH(iterator, event)           \
-    for (Member iterator = eventGetFirst(event); \
-         iterator;                               \
+#define EVENT_FOREACH(iterator, event)            \
+    for (int iterator = eventGetFirst(event);     \
+         iterator != EVENT_NO_MEMBER;             \
          iterator = eventGetNext(event))
 
 #endif /* EVENT_H_ */
\ No newline at end of file
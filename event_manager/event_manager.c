@@ -2,59 +2,222 @@
 #include "event.h"
 #include "member.h"
 #include "priority_queue.h"
+#include "intern.h"
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <stdint.h>
 #include <assert.h>
 
 #define NULL_EM -1
+#define MIN_NAME_DATE_CAPACITY 16
+#define NAME_DATE_LOAD_FACTOR 2
 
+/** A slot of the name and date index. event is NULL for an empty slot */
+typedef struct NameDateSlot_t
+{
+    Event event;
+    unsigned int hash;
+} NameDateSlot;
+
+/**
+* name_date_slots is an open addressing hash table (linear probing, capacity a power of two)
+* holding every event of the events queue by the hash of its name and date, so finding an
+* event with a given name and date does not scan the queue.
+*/
 struct EventManager_t
 {
     Date date;
     PriorityQueue events;
     PriorityQueue members;
+    NameDateSlot *name_date_slots;
+    int name_date_capacity;
+    int name_date_size;
 };
 
-static Event getEventByNameAndDate(PriorityQueue pq, char *event_name, Date date)
+/**
+* The events queue stores the date of each event by value inside the priority pointer itself, so
+* priorities are never allocated. The sign bit is flipped so that only DATE_VALUE_INVALID, which
+* no event has, would be encoded as NULL.
+*/
+static PQElementPriority dateToPriority(DateValue date)
+{
+    return (PQElementPriority)(uintptr_t)((uint32_t)date ^ (uint32_t)DATE_VALUE_INVALID);
+}
+
+static DateValue priorityToDate(PQElementPriority priority)
+{
+    return (DateValue)((uint32_t)(uintptr_t)priority ^ (uint32_t)DATE_VALUE_INVALID);
+}
+
+static bool eventHasIdGeneric(PQElement event, const void *event_id)
+{
+    return eventGetId((Event)event) == *(const int *)event_id;
+}
+
+static bool memberHasIdGeneric(PQElement member, const void *member_id)
+{
+    return memberGetId((Member)member) == *(const int *)member_id;
+}
+
+/** Mixes all bits of an id into the low bits, which pick the slot in the key index */
+static unsigned int hashId(int id)
+{
+    uint32_t hash = (uint32_t)id;
+    hash ^= hash >> 16;
+    hash *= 0x85ebca6bu;
+    hash ^= hash >> 13;
+    hash *= 0xc2b2ae35u;
+    hash ^= hash >> 16;
+    return hash;
+}
+
+static unsigned int hashNameAndDate(unsigned int name_hash, DateValue date)
 {
-    PQ_FOREACH(Event, iterator, pq)
+    return hashId((int)(name_hash * 31u + (uint32_t)date));
+}
+
+static unsigned int hashEventNameAndDate(Event event)
+{
+    return hashNameAndDate(eventGetNameHash(event), eventGetDate(event));
+}
+
+/** Makes sure the name and date index can hold count events while staying under its load factor */
+static EventManagerResult nameDateReserve(EventManager em, int count)
+{
+    if (count * NAME_DATE_LOAD_FACTOR <= em->name_date_capacity)
+    {
+        return EM_SUCCESS;
+    }
+    int capacity = MIN_NAME_DATE_CAPACITY;
+    while (capacity < count * NAME_DATE_LOAD_FACTOR)
     {
-        if (strcmp(eventGetName(iterator), event_name) == 0)
+        capacity *= 2;
+    }
+    NameDateSlot *slots = calloc(capacity, sizeof(*slots));
+    if (slots == NULL)
+    {
+        return EM_OUT_OF_MEMORY;
+    }
+    unsigned int mask = (unsigned int)capacity - 1;
+    for (int i = 0; i < em->name_date_capacity; i++)
+    {
+        if (em->name_date_slots[i].event == NULL)
+        {
+            continue;
+        }
+        unsigned int slot = em->name_date_slots[i].hash & mask;
+        while (slots[slot].event != NULL)
         {
-            if (dateCompare(date, eventGetDate(iterator)) == 0)
-            {
-                return iterator;
-            }
+            slot = (slot + 1) & mask;
         }
+        slots[slot] = em->name_date_slots[i];
     }
-    return NULL;
+    free(em->name_date_slots);
+    em->name_date_slots = slots;
+    em->name_date_capacity = capacity;
+    return EM_SUCCESS;
 }
 
-static Event getEventById(PriorityQueue pq, int event_id)
+/** Adds an event stored in the events queue to the name and date index, which has room for it */
+static void nameDateAdd(EventManager em, Event event)
+{
+    assert(em->name_date_size < em->name_date_capacity);
+    unsigned int mask = (unsigned int)em->name_date_capacity - 1;
+    unsigned int hash = hashEventNameAndDate(event);
+    unsigned int slot = hash & mask;
+    while (em->name_date_slots[slot].event != NULL)
+    {
+        slot = (slot + 1) & mask;
+    }
+    em->name_date_slots[slot].event = event;
+    em->name_date_slots[slot].hash = hash;
+    em->name_date_size++;
+}
+
+/**
+* Removes an event from the name and date index, shifting back the entries that probed past it.
+* Must be called while the event still has the name and date it was added with.
+*/
+static void nameDateRemove(EventManager em, Event event)
 {
-    PQ_FOREACH(Event, iterator, pq)
+    unsigned int mask = (unsigned int)em->name_date_capacity - 1;
+    unsigned int slot = hashEventNameAndDate(event) & mask;
+    while (em->name_date_slots[slot].event != event)
     {
-        if (eventGetId(iterator) == event_id)
+        assert(em->name_date_slots[slot].event != NULL);
+        slot = (slot + 1) & mask;
+    }
+
+    unsigned int next = slot;
+    while (true)
+    {
+        next = (next + 1) & mask;
+        if (em->name_date_slots[next].event == NULL)
+        {
+            break;
+        }
+        unsigned int home = em->name_date_slots[next].hash & mask;
+        if (((next - home) & mask) >= ((next - slot) & mask))
         {
-            return iterator;
+            em->name_date_slots[slot] = em->name_date_slots[next];
+            slot = next;
         }
     }
-    return NULL;
+    em->name_date_slots[slot].event = NULL;
+    em->name_date_size--;
 }
 
-static Member getMemberById(PriorityQueue pq, int member_id)
+/**
+* Event names are interned, so a name no event has is not in the intern table at all, and the
+* name of a candidate event is compared by pointer once its hash and date match.
+*/
+static Event getEventByNameAndDate(EventManager em, char *event_name, DateValue date)
 {
-    PQ_FOREACH(Member, iterator, pq)
+    char *interned_name = internFind(event_name);
+    if (interned_name == NULL || em->name_date_capacity == 0)
     {
-        if (memberGetId(iterator) == member_id)
+        return NULL;
+    }
+    unsigned int mask = (unsigned int)em->name_date_capacity - 1;
+    unsigned int hash = hashNameAndDate(internGetHash(interned_name), date);
+    for (unsigned int slot = hash & mask; em->name_date_slots[slot].event != NULL; slot = (slot + 1) & mask)
+    {
+        Event event = em->name_date_slots[slot].event;
+        if (em->name_date_slots[slot].hash == hash && eventGetDate(event) == date &&
+            eventGetName(event) == interned_name)
         {
-            return iterator;
+            return event;
         }
     }
     return NULL;
 }
 
+static unsigned int hashIdGeneric(const void *id)
+{
+    return hashId(*(const int *)id);
+}
+
+static unsigned int hashEventIdGeneric(PQElement event)
+{
+    return hashId(eventGetId((Event)event));
+}
+
+static unsigned int hashMemberIdGeneric(PQElement member)
+{
+    return hashId(memberGetId((Member)member));
+}
+
+static Event getEventById(PriorityQueue pq, int event_id)
+{
+    return (Event)pqFindBy(pq, &event_id, eventHasIdGeneric);
+}
+
+static Member getMemberById(PriorityQueue pq, int member_id)
+{
+    return (Member)pqFindBy(pq, &member_id, memberHasIdGeneric);
+}
+
 static int compareMemberPriorities(PQElementPriority member1, PQElementPriority member2)
 {
     return ((memberGetEventNumber((Member)member1) - memberGetEventNumber((Member)member2)) != 0)
@@ -96,18 +259,98 @@ static bool compareEventsGeneric(PQElement event1, PQElement event2)
 
 static PQElementPriority copyDateGeneric(PQElementPriority date)
 {
-    Date date_copy = dateCopy((Date)date);
-    return date_copy;
+    return date;
 }
 
 static void freeDateGeneric(PQElementPriority date)
 {
-    dateDestroy((Date)date);
 }
 
 static int compareDatesGeneric(PQElementPriority date1, PQElementPriority date2)
 {
-    return (0 - dateCompare((Date)date1, (Date)date2));
+    return (0 - dateValueCompare(priorityToDate(date1), priorityToDate(date2)));
+}
+
+/**
+* Changes the event number of a member by delta and moves it to its new place in the members
+* queue. The member is its own priority there, so it is taken out of the queue before it
+* changes.
+* Removing keeps the capacity of the queue and copying a member only takes a reference, so
+* putting it back does not allocate. Should it fail anyway, the member is put back with its
+* old event number, and on EM_OUT_OF_MEMORY nothing has changed.
+*/
+static EventManagerResult changeMemberEventNumber(EventManager em, Member member, int delta)
+{
+    Member held = memberCopy(member);
+    int event_number = memberGetEventNumber(held);
+    pqRemoveElement(em->members, held);
+    memberChangeEventNumber(held, event_number + delta);
+    PriorityQueueResult result = pqInsert(em->members, held, held);
+    if (result == PQ_OUT_OF_MEMORY)
+    {
+        memberChangeEventNumber(held, event_number);
+        PriorityQueueResult restored = pqInsert(em->members, held, held);
+        assert(restored == PQ_SUCCESS);
+        (void)restored;
+    }
+    memberDestroy(held);
+    return result == PQ_OUT_OF_MEMORY ? EM_OUT_OF_MEMORY : EM_SUCCESS;
+}
+
+/**
+* Unlinks every member of the event from it and decreases their event number, before the
+* event is removed. The event only holds member ids, they are looked up in the members queue.
+* All the members are looked up before any of them changes, so on EM_ERROR nothing has
+* changed. After that the release cannot fail: changeMemberEventNumber does not allocate and
+* a member always has the events it is linked to.
+*/
+static EventManagerResult releaseEventMembers(EventManager em, Event event)
+{
+    EVENT_FOREACH(member_id, event)
+    {
+        if (getMemberById(em->members, member_id) == NULL)
+        {
+            return EM_ERROR;
+        }
+    }
+    EVENT_FOREACH(member_id, event)
+    {
+        Member member = getMemberById(em->members, member_id);
+        EventManagerResult result = changeMemberEventNumber(em, member, -1);
+        assert(result == EM_SUCCESS);
+        (void)result;
+        memberRemoveEvent(member, eventGetId(event));
+    }
+    return EM_SUCCESS;
+}
+
+/** Context of removePastEventGeneric, keeping the first error met while releasing members.
+* An event whose members could not be released stays in the queue. */
+typedef struct TickContext_t
+{
+    EventManager em;
+    EventManagerResult result;
+} TickContext;
+
+static bool removePastEventGeneric(PQElement event, PQElementPriority date, void *context)
+{
+    TickContext *tick = context;
+    if (dateValueCompare(priorityToDate(date), dateSerial(tick->em->date)) >= 0)
+    {
+        return false;
+    }
+
+    EventManagerResult result = releaseEventMembers(tick->em, (Event)event);
+    if (result != EM_SUCCESS)
+    {
+        if (tick->result == EM_SUCCESS)
+        {
+            tick->result = result;
+        }
+        return false;
+    }
+    nameDateRemove(tick->em, (Event)event);
+    return true;
 }
 
 EventManager createEventManager(Date date)
@@ -125,16 +368,18 @@ EventManager createEventManager(Date date)
 
     em->events = pqCreate(copyEventGeneric, freeEventGeneric, compareEventsGeneric,
                           copyDateGeneric, freeDateGeneric, compareDatesGeneric);
-    if (em->events == NULL)
+    if (em->events == NULL || pqSetKeyIndex(em->events, hashEventIdGeneric, hashIdGeneric) != PQ_SUCCESS)
     {
+        pqDestroy(em->events);
         free(em);
         return NULL;
     }
 
     em->members = pqCreate(copyMemberGeneric, freeMemberGeneric, compareMembersGeneric,
                            copyMemberGeneric, freeMemberGeneric, compareMemberPriorities);
-    if (em->members == NULL)
+    if (em->members == NULL || pqSetKeyIndex(em->members, hashMemberIdGeneric, hashIdGeneric) != PQ_SUCCESS)
     {
+        pqDestroy(em->members);
         pqDestroy(em->events);
         free(em);
         return NULL;
@@ -150,6 +395,9 @@ EventManager createEventManager(Date date)
     }
 
     em->date = new_date;
+    em->name_date_slots = NULL;
+    em->name_date_capacity = 0;
+    em->name_date_size = 0;
     return em;
 }
 
@@ -163,6 +411,7 @@ void destroyEventManager(EventManager em)
     pqDestroy(em->events);
     pqDestroy(em->members);
     dateDestroy(em->date);
+    free(em->name_date_slots);
     free(em);
 }
 
@@ -183,7 +432,8 @@ EventManagerResult emAddEventByDate(EventManager em, char *event_name, Date date
         return EM_INVALID_EVENT_ID;
     }
 
-    Event tmp = getEventByNameAndDate(em->events, event_name, date);
+    DateValue date_value = dateSerial(date);
+    Event tmp = getEventByNameAndDate(em, event_name, date_value);
     if (tmp != NULL)
     {
         return EM_EVENT_ALREADY_EXISTS;
@@ -195,19 +445,26 @@ EventManagerResult emAddEventByDate(EventManager em, char *event_name, Date date
         return EM_EVENT_ID_ALREADY_EXISTS;
     }
 
-    Event new_event = eventCreate(event_id, event_name, date);
+    if (nameDateReserve(em, em->name_date_size + 1) == EM_OUT_OF_MEMORY)
+    {
+        return EM_OUT_OF_MEMORY;
+    }
+
+    Event new_event = eventCreate(event_id, event_name, date_value);
     if (new_event == NULL)
     {
         return EM_OUT_OF_MEMORY;
     }
 
-    if (pqInsert(em->events, new_event, date) == PQ_OUT_OF_MEMORY)
+    if (pqInsert(em->events, new_event, dateToPriority(date_value)) == PQ_OUT_OF_MEMORY)
     {
         eventDestroy(new_event);
         return EM_OUT_OF_MEMORY;
     }
 
     eventDestroy(new_event);
+    // the queue stores a copy of the event, which is the one to index
+    nameDateAdd(em, getEventById(em->events, event_id));
     return EM_SUCCESS;
 }
 
@@ -218,7 +475,8 @@ EventManagerResult emAddEventByDiff(EventManager em, char *event_name, int days,
         return EM_NULL_ARGUMENT;
     }
 
-    if (days < 0)
+    // a date more days away than the last legal date is invalid, not moved to it
+    if (days < 0 || (int64_t)dateSerial(em->date) + days > DATE_VALUE_MAX)
     {
         return EM_INVALID_DATE;
     }
@@ -229,10 +487,7 @@ EventManagerResult emAddEventByDiff(EventManager em, char *event_name, int days,
         return EM_OUT_OF_MEMORY;
     }
 
-    for (int i = 0; i < days; i++)
-    {
-        dateTick(new_date);
-    }
+    dateAdvance(new_date, days);
     EventManagerResult result = emAddEventByDate(em, event_name, new_date, event_id);
     dateDestroy(new_date);
     return result;
@@ -256,29 +511,12 @@ EventManagerResult emRemoveEvent(EventManager em, int event_id)
         return EM_EVENT_NOT_EXISTS;
     }
 
-    Member tmp_member2 = NULL;
-    EVENT_FOREACH(iterator, tmp)
+    EventManagerResult result = releaseEventMembers(em, tmp);
+    if (result != EM_SUCCESS)
     {
-        Member tmp_member = getMemberById(em->members, memberGetId(iterator));
-        if (tmp_member == NULL)
-        {
-            return EM_ERROR;
-        }
-
-        tmp_member2 = memberCopy(tmp_member);
-        if (tmp_member2 == NULL)
-        {
-            return EM_OUT_OF_MEMORY;
-        }
-
-        memberChangeEventNumber(tmp_member2, memberGetEventNumber(tmp_member2) - 1);
-        pqRemoveElement(em->members, tmp_member);
-        if (pqInsert(em->members, tmp_member2, tmp_member2) == PQ_OUT_OF_MEMORY)
-        {
-            return EM_OUT_OF_MEMORY;
-        }
-        memberDestroy(tmp_member2);
+        return result;
     }
+    nameDateRemove(em, tmp);
     pqRemoveElement(em->events, tmp);
 
     return EM_SUCCESS;
@@ -307,29 +545,24 @@ EventManagerResult emChangeEventDate(EventManager em, int event_id, Date new_dat
         return EM_EVENT_ID_NOT_EXISTS;
     }
 
-    Event tmp2 = getEventByNameAndDate(em->events, eventGetName(tmp), new_date);
+    DateValue new_date_value = dateSerial(new_date);
+    Event tmp2 = getEventByNameAndDate(em, eventGetName(tmp), new_date_value);
     if (tmp2 != NULL)
     {
         return EM_EVENT_ALREADY_EXISTS;
     }
 
-    PriorityQueueResult result2 = pqChangePriority(em->events, tmp, eventGetDate(tmp), new_date);
+    // the stored event is moved rather than replaced by a copy, so tmp stays valid
+    PriorityQueueResult result2 = pqMoveElement(em->events, tmp, dateToPriority(eventGetDate(tmp)),
+                                                dateToPriority(new_date_value));
     if (result2 == PQ_OUT_OF_MEMORY)
     {
         return EM_OUT_OF_MEMORY;
     }
 
-    tmp = getEventById(em->events, event_id);
-    if (tmp == NULL)
-    {
-        return EM_EVENT_ID_NOT_EXISTS;
-    }
-
-    EventResult result = eventChangeDate(tmp, new_date);
-    if (result == EVENT_OUT_OF_MEMORY)
-    {
-        return EM_OUT_OF_MEMORY;
-    }
+    nameDateRemove(em, tmp);
+    eventChangeDate(tmp, new_date_value);
+    nameDateAdd(em, tmp);
 
     return EM_SUCCESS;
 }
@@ -368,6 +601,92 @@ EventManagerResult emAddMember(EventManager em, char *member_name, int member_id
     return EM_SUCCESS;
 }
 
+/**
+* Removes a member from every event it attends, found through its reverse index, so it costs
+* O(k) for k events instead of a scan of all of them.
+*/
+static void unlinkMemberFromEvents(EventManager em, Member member)
+{
+    int member_id = memberGetId(member);
+    ATTENDEE_SET_FOREACH(event_id, memberGetEvents(member))
+    {
+        eventRemoveMember(getEventById(em->events, event_id), member_id);
+    }
+}
+
+EventManagerResult emRemoveMember(EventManager em, int member_id)
+{
+    if (em == NULL)
+    {
+        return EM_NULL_ARGUMENT;
+    }
+
+    if (member_id < 0)
+    {
+        return EM_INVALID_MEMBER_ID;
+    }
+
+    Member member = getMemberById(em->members, member_id);
+    if (member == NULL)
+    {
+        return EM_MEMBER_ID_NOT_EXISTS;
+    }
+
+    unlinkMemberFromEvents(em, member);
+    pqRemoveElement(em->members, member);
+    return EM_SUCCESS;
+}
+
+static bool isRemovedMemberGeneric(PQElement member, PQElementPriority priority, void *member_ids)
+{
+    return attendeeSetContains((AttendeeSet)member_ids, memberGetId((Member)member));
+}
+
+/**
+* Either all the members are removed or none of them. They leave the members queue in a single
+* pass over it, rather than a shift of the queue for every member.
+*/
+EventManagerResult emRemoveMembers(EventManager em, const int *member_ids, int members_amount)
+{
+    if (em == NULL || (member_ids == NULL && members_amount > 0))
+    {
+        return EM_NULL_ARGUMENT;
+    }
+
+    AttendeeSet removed = attendeeSetCreate();
+    if (removed == NULL)
+    {
+        return EM_OUT_OF_MEMORY;
+    }
+    EventManagerResult result = EM_SUCCESS;
+    for (int i = 0; i < members_amount && result == EM_SUCCESS; i++)
+    {
+        if (member_ids[i] < 0)
+        {
+            result = EM_INVALID_MEMBER_ID;
+        }
+        else if (getMemberById(em->members, member_ids[i]) == NULL)
+        {
+            result = EM_MEMBER_ID_NOT_EXISTS;
+        }
+        else if (attendeeSetAdd(removed, member_ids[i]) == ATTENDEE_SET_OUT_OF_MEMORY)
+        {
+            result = EM_OUT_OF_MEMORY;
+        }
+    }
+
+    if (result == EM_SUCCESS && attendeeSetGetSize(removed) > 0)
+    {
+        ATTENDEE_SET_FOREACH(member_id, removed)
+        {
+            unlinkMemberFromEvents(em, getMemberById(em->members, member_id));
+        }
+        pqRemoveIf(em->members, isRemovedMemberGeneric, removed);
+    }
+    attendeeSetDestroy(removed);
+    return result;
+}
+
 EventManagerResult emAddMemberToEvent(EventManager em, int member_id, int event_id)
 {
     if (em == NULL)
@@ -397,24 +716,27 @@ EventManagerResult emAddMemberToEvent(EventManager em, int member_id, int event_
         return EM_MEMBER_ID_NOT_EXISTS;
     }
 
-    EVENT_FOREACH(iterator, ev_tmp)
+    EventResult result = eventAddMember(ev_tmp, member_id);
+    if (result == EVENT_MEMBER_ALREADY_EXISTS)
     {
-        if (memberGetId(iterator) == member_id)
-        {
-            return EM_EVENT_AND_MEMBER_ALREADY_LINKED;
-        }
+        return EM_EVENT_AND_MEMBER_ALREADY_LINKED;
     }
-
-    if (eventAddMember(ev_tmp, member_tmp) == EVENT_OUT_OF_MEMORY)
+    if (result == EVENT_OUT_OF_MEMORY)
+    {
+        return EM_OUT_OF_MEMORY;
+    }
+    if (memberAddEvent(member_tmp, event_id) == MEMBER_OUT_OF_MEMORY)
     {
+        eventRemoveMember(ev_tmp, member_id);
+        return EM_OUT_OF_MEMORY;
+    }
+    if (changeMemberEventNumber(em, member_tmp, 1) == EM_OUT_OF_MEMORY)
+    {
+        memberRemoveEvent(member_tmp, event_id);
+        eventRemoveMember(ev_tmp, member_id);
         return EM_OUT_OF_MEMORY;
     }
 
-    Member member_copy = memberCopy(member_tmp);
-    pqRemoveElement(em->members, member_tmp);
-    memberChangeEventNumber(member_copy, memberGetEventNumber(member_copy) + 1);
-    pqInsert(em->members, member_copy, member_copy);
-    memberDestroy(member_copy);
     return EM_SUCCESS;
 }
 
@@ -447,25 +769,17 @@ EventManagerResult emRemoveMemberFromEvent(EventManager em, int member_id, int e
         return EM_MEMBER_ID_NOT_EXISTS;
     }
 
-    if (eventRemoveMember(ev_tmp, member_tmp) == EVENT_MEMBER_DOES_NOT_EXIST)
+    if (!eventHasMember(ev_tmp, member_id))
     {
         return EM_EVENT_AND_MEMBER_NOT_LINKED;
     }
-
-    Member tmp_member2 = memberCopy(member_tmp);
-    if (tmp_member2 == NULL)
+    // unlinking cannot fail, so the event number is changed first
+    if (changeMemberEventNumber(em, member_tmp, -1) == EM_OUT_OF_MEMORY)
     {
         return EM_OUT_OF_MEMORY;
     }
-
-    memberChangeEventNumber(tmp_member2, memberGetEventNumber(tmp_member2) - 1);
-    pqRemoveElement(em->members, member_tmp);
-    if (pqInsert(em->members, tmp_member2, tmp_member2) == PQ_OUT_OF_MEMORY)
-    {
-        memberDestroy(tmp_member2);
-        return EM_OUT_OF_MEMORY;
-    }
-    memberDestroy(tmp_member2);
+    eventRemoveMember(ev_tmp, member_id);
+    memberRemoveEvent(member_tmp, event_id);
 
     return EM_SUCCESS;
 }
@@ -481,21 +795,12 @@ EventManagerResult emTick(EventManager em, int days)
         return EM_INVALID_DATE;
     }
 
-    for (int i = 0; i < days; i++)
-    {
-        dateTick(em->date);
-    }
+    dateAdvance(em->date, days);
 
-    while (1)
-    {
-        if (dateCompare(eventGetDate(pqGetFirst(em->events)), em->date) >= 0)
-        {
-            break;
-        }
-        emRemoveEvent(em, eventGetId(pqGetFirst(em->events)));
-    }
+    TickContext tick = {em, EM_SUCCESS};
+    pqRemoveIf(em->events, removePastEventGeneric, &tick);
 
-    return EM_SUCCESS;
+    return tick.result;
 }
 
 int emGetEventsAmount(EventManager em)
@@ -517,6 +822,12 @@ char *emGetNextEvent(EventManager em)
     return eventGetName(tmp);
 }
 
+/** Returns the name of a member for eventPrint, context is the event manager */
+static char *memberNameGeneric(int member_id, void *em)
+{
+    return memberGetName(getMemberById(((EventManager)em)->members, member_id));
+}
+
 void emPrintAllEvents(EventManager em, const char *file_name)
 {
     FILE *file = fopen(file_name, "w");
@@ -527,7 +838,7 @@ void emPrintAllEvents(EventManager em, const char *file_name)
 
     PQ_FOREACH(Event, iterator, em->events)
     {
-        eventPrint(iterator, file);
+        eventPrint(iterator, file, memberNameGeneric, em);
         fprintf(file, "\n");
     }
     fclose(file);
@@ -550,4 +861,106 @@ void emPrintAllResponsibleMembers(EventManager em, const char *file_name)
         }
     }
     fclose(file);
-}
\ No newline at end of file
+}
+
+int emGetMemberEvents(EventManager em, int member_id, int cursor, int *event_ids, int size)
+{
+    if (em == NULL || event_ids == NULL || size < 0)
+    {
+        return NULL_EM;
+    }
+    Member member = getMemberById(em->members, member_id);
+    if (member == NULL)
+    {
+        return NULL_EM;
+    }
+    AttendeeSet events = memberGetEvents(member);
+    // a member that never attended an event has no set
+    return events != NULL ? attendeeSetGetNextIds(events, cursor, event_ids, size) : 0;
+}
+
+/** Returns the set of the member IDs of an event, NULL if it does not exist */
+static AttendeeSet getEventMembers(EventManager em, int event_id)
+{
+    return eventGetMembers(getEventById(em->events, event_id));
+}
+
+/**
+* Counts the members of an event after combining them with the members of each of the other
+* events, on a copy of the set of the first event.
+* Returns NULL_EM if one of the events does not exist or an allocation failed.
+*/
+static int countCombinedMembers(EventManager em, int event_id, const int *event_ids, int events_amount,
+                                AttendeeSetResult (*combine)(AttendeeSet, AttendeeSet))
+{
+    AttendeeSet members = attendeeSetCopy(getEventMembers(em, event_id));
+    for (int i = 0; members != NULL && i < events_amount; i++)
+    {
+        AttendeeSet other = getEventMembers(em, event_ids[i]);
+        if (other == NULL || combine(members, other) != ATTENDEE_SET_SUCCESS)
+        {
+            attendeeSetDestroy(members);
+            members = NULL;
+        }
+    }
+    int count = members != NULL ? attendeeSetGetSize(members) : NULL_EM;
+    attendeeSetDestroy(members);
+    return count;
+}
+
+int emCountMembersInAllEvents(EventManager em, const int *event_ids, int events_amount)
+{
+    if (em == NULL || event_ids == NULL || events_amount < 1)
+    {
+        return NULL_EM;
+    }
+    if (events_amount == 2)
+    {
+        // two sets are counted without building their intersection
+        return attendeeSetGetIntersectionSize(getEventMembers(em, event_ids[0]),
+                                              getEventMembers(em, event_ids[1]));
+    }
+    return countCombinedMembers(em, event_ids[0], event_ids + 1, events_amount - 1, attendeeSetIntersect);
+}
+
+int emCountMembersInAnyEvent(EventManager em, const int *event_ids, int events_amount)
+{
+    if (em == NULL || events_amount < 0 || (event_ids == NULL && events_amount > 0))
+    {
+        return NULL_EM;
+    }
+    if (events_amount == 0)
+    {
+        return 0;
+    }
+    if (events_amount == 2)
+    {
+        return attendeeSetGetUnionSize(getEventMembers(em, event_ids[0]), getEventMembers(em, event_ids[1]));
+    }
+    return countCombinedMembers(em, event_ids[0], event_ids + 1, events_amount - 1, attendeeSetUnite);
+}
+
+int emCountMembersInNoEvent(EventManager em, const int *event_ids, int events_amount)
+{
+    int in_any = emCountMembersInAnyEvent(em, event_ids, events_amount);
+    if (in_any == NULL_EM)
+    {
+        return NULL_EM;
+    }
+    // events only hold registered members, so the rest of the members are in none of them
+    return pqGetSize(em->members) - in_any;
+}
+
+int emCountMembersOnlyInEvent(EventManager em, int event_id, const int *other_event_ids, int events_amount)
+{
+    if (em == NULL || events_amount < 0 || (other_event_ids == NULL && events_amount > 0))
+    {
+        return NULL_EM;
+    }
+    if (events_amount == 1)
+    {
+        return attendeeSetGetDifferenceSize(getEventMembers(em, event_id),
+                                            getEventMembers(em, other_event_ids[0]));
+    }
+    return countCombinedMembers(em, event_id, other_event_ids, events_amount, attendeeSetSubtract);
+}
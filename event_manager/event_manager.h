@@ -38,6 +38,10 @@ EventManagerResult emChangeEventDate(EventManager em, int event_id, Date new_dat
 
 EventManagerResult emAddMember(EventManager em, char* member_name, int member_id);
 
+EventManagerResult emRemoveMember(EventManager em, int member_id);
+
+EventManagerResult emRemoveMembers(EventManager em, const int* member_ids, int members_amount);
+
 EventManagerResult emAddMemberToEvent(EventManager em, int member_id, int event_id);
 
 EventManagerResult emRemoveMemberFromEvent (EventManager em, int member_id, int event_id);
@@ -51,4 +55,14 @@ char* emGetNextEvent(EventManager em);
 void emPrintAllEvents(EventManager em, const char* file_name);
 
 void emPrintAllResponsibleMembers(EventManager em, const char* file_name);
+
+int emGetMemberEvents(EventManager em, int member_id, int cursor, int* event_ids, int size);
+
+int emCountMembersInAllEvents(EventManager em, const int* event_ids, int events_amount);
+
+int emCountMembersInAnyEvent(EventManager em, const int* event_ids, int events_amount);
+
+int emCountMembersInNoEvent(EventManager em, const int* event_ids, int events_amount);
+
+int emCountMembersOnlyInEvent(EventManager em, int event_id, const int* other_event_ids, int events_amount);
 #endif //EVENT_MANAGER_H
\ No newline at end of file
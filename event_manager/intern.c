@@ -0,0 +1,199 @@
+#include "intern.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define MIN_CAPACITY 64
+#define LOAD_FACTOR 2
+#define FNV_OFFSET_BASIS 2166136261u
+#define FNV_PRIME 16777619u
+
+/** An interned string, text is what callers get a pointer to */
+typedef struct InternEntry_t
+{
+    int references;
+    uint32_t hash;
+    char text[];
+} *InternEntry;
+
+/**
+* Open addressing hash table of the interned strings. capacity is 0 or a power of two and
+* an empty slot holds NULL. The slots are freed whenever the table becomes empty.
+*/
+static struct
+{
+    InternEntry *slots;
+    int capacity;
+    int size;
+    long lookups;
+    long hits;
+} table;
+
+static InternEntry entryOf(const char *text)
+{
+    return (InternEntry)(text - offsetof(struct InternEntry_t, text));
+}
+
+static uint32_t hashString(const char *string)
+{
+    uint32_t hash = FNV_OFFSET_BASIS;
+    for (; *string; string++)
+    {
+        hash = (hash ^ (unsigned char)*string) * FNV_PRIME;
+    }
+    return hash;
+}
+
+/** Returns the slot holding string, or the empty slot where it belongs */
+static int findSlot(const char *string, uint32_t hash)
+{
+    int mask = table.capacity - 1;
+    int slot = (int)(hash & (uint32_t)mask);
+    while (table.slots[slot] &&
+           (table.slots[slot]->hash != hash || strcmp(table.slots[slot]->text, string) != 0))
+    {
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+static bool reserve(int size)
+{
+    if (size * LOAD_FACTOR <= table.capacity)
+    {
+        return true;
+    }
+    int capacity = table.capacity > 0 ? table.capacity : MIN_CAPACITY;
+    while (size * LOAD_FACTOR > capacity)
+    {
+        capacity *= 2;
+    }
+    InternEntry *slots = calloc(capacity, sizeof(*slots));
+    if (!slots)
+    {
+        return false;
+    }
+    InternEntry *old_slots = table.slots;
+    int old_capacity = table.capacity;
+    table.slots = slots;
+    table.capacity = capacity;
+    for (int i = 0; i < old_capacity; i++)
+    {
+        if (old_slots[i])
+        {
+            table.slots[findSlot(old_slots[i]->text, old_slots[i]->hash)] = old_slots[i];
+        }
+    }
+    free(old_slots);
+    return true;
+}
+
+char *internString(const char *string)
+{
+    if (!string)
+    {
+        return NULL;
+    }
+    table.lookups++;
+    uint32_t hash = hashString(string);
+    if (table.size > 0)
+    {
+        int slot = findSlot(string, hash);
+        if (table.slots[slot])
+        {
+            table.hits++;
+            table.slots[slot]->references++;
+            return table.slots[slot]->text;
+        }
+    }
+    if (!reserve(table.size + 1))
+    {
+        return NULL;
+    }
+    size_t size = strlen(string) + 1;
+    InternEntry entry = malloc(sizeof(*entry) + size);
+    if (!entry)
+    {
+        return NULL;
+    }
+    entry->references = 1;
+    entry->hash = hash;
+    memcpy(entry->text, string, size);
+    table.slots[findSlot(string, hash)] = entry;
+    table.size++;
+    return entry->text;
+}
+
+char *internFind(const char *string)
+{
+    if (!string || table.size == 0)
+    {
+        return NULL;
+    }
+    InternEntry entry = table.slots[findSlot(string, hashString(string))];
+    return entry ? entry->text : NULL;
+}
+
+char *internRetain(char *string)
+{
+    if (string)
+    {
+        entryOf(string)->references++;
+    }
+    return string;
+}
+
+/**
+* The last reference removes the entry with backward shift deletion, so lookups never
+* need tombstones.
+*/
+void internRelease(char *string)
+{
+    if (!string)
+    {
+        return;
+    }
+    InternEntry entry = entryOf(string);
+    if (--entry->references > 0)
+    {
+        return;
+    }
+    int mask = table.capacity - 1;
+    int hole = findSlot(entry->text, entry->hash);
+    table.slots[hole] = NULL;
+    table.size--;
+    free(entry);
+    if (table.size == 0)
+    {
+        free(table.slots);
+        table.slots = NULL;
+        table.capacity = 0;
+        return;
+    }
+    for (int slot = (hole + 1) & mask; table.slots[slot]; slot = (slot + 1) & mask)
+    {
+        int home = (int)(table.slots[slot]->hash & (uint32_t)mask);
+        if (((slot - home) & mask) >= ((slot - hole) & mask))
+        {
+            table.slots[hole] = table.slots[slot];
+            table.slots[slot] = NULL;
+            hole = slot;
+        }
+    }
+}
+
+unsigned int internGetHash(const char *string)
+{
+    return string ? entryOf(string)->hash : 0;
+}
+
+int internGetSize(void)
+{
+    return table.size;
+}
+
+double internGetHitRate(void)
+{
+    return table.lookups > 0 ? (double)table.hits / table.lookups : 0;
+}
@@ -0,0 +1,84 @@
+#ifndef INTERN_H_
+#define INTERN_H_
+
+#include <stdbool.h>
+
+/**
+* String intern table
+*
+* Implements a global table of immutable, reference counted strings. Interning the
+* same text twice returns the same pointer, so every holder of a name shares a single
+* copy of it and interned strings are equal exactly when their pointers are equal.
+* The table is not thread safe.
+*
+* The following functions are available:
+*   internString        - Returns the shared copy of a string, adding it if needed.
+*   internFind          - Returns the shared copy of a string if it was interned.
+*   internRetain        - Adds a reference to an interned string.
+*   internRelease       - Drops a reference to an interned string.
+*   internGetHash       - Returns the hash of an interned string without rehashing it.
+*   internGetSize       - Returns the number of distinct strings in the table.
+*   internGetHitRate    - Returns the part of internString calls that found their string.
+*/
+
+/**
+* internString: Returns the shared copy of a string, adding it to the table if needed.
+* Every returned string holds a reference that must be dropped with internRelease.
+*
+* @param string - The text to intern.
+* @return
+* 	NULL if a NULL was sent or a memory allocation failed.
+* 	The shared copy of string otherwise. It must not be modified.
+*/
+char *internString(const char *string);
+
+/**
+* internFind: Returns the shared copy of a string without adding it or taking a reference.
+*
+* @param string - The text to look up.
+* @return
+* 	NULL if a NULL was sent or the string is not in the table.
+* 	The shared copy of string otherwise.
+*/
+char *internFind(const char *string);
+
+/**
+* internRetain: Adds a reference to an interned string, this is how an interned string
+* is copied.
+*
+* @param string - A string returned by internString. If NULL nothing will be done.
+* @return
+* 	string.
+*/
+char *internRetain(char *string);
+
+/**
+* internRelease: Drops a reference to an interned string, the last one removes it from
+* the table.
+*
+* @param string - A string returned by internString. If NULL nothing will be done.
+*/
+void internRelease(char *string);
+
+/**
+* internGetHash: Returns the hash of an interned string, computed once when it was added.
+*
+* @param string - A string returned by internString.
+* @return
+* 	0 if a NULL was sent.
+* 	The hash of string otherwise.
+*/
+unsigned int internGetHash(const char *string);
+
+/**
+* internGetSize: Returns the number of distinct strings in the table.
+*/
+int internGetSize(void);
+
+/**
+* internGetHitRate: Returns the fraction of internString calls that found their string
+* already in the table, between 0 and 1. 0 if internString was never called.
+*/
+double internGetHitRate(void);
+
+#endif /* INTERN_H_ */
@@ -3,27 +3,26 @@
 #include <stdio.h>
 #include <string.h>
 #include "member.h"
+#include "intern.h"
 
 #define NULL_MEMBER -1
 
+/**
+* Members are reference counted: every holder of a member, such as the members queue of
+* the event manager, shares the same object.
+* events holds the IDs of the events the member attends, the reverse of the members of
+* an event, and is kept by the event manager alongside event_number. It is created by the
+* first event the member attends, so members that attend none do not allocate it.
+*/
 struct Member_t
 {
     int id;
     char *name;
     int event_number;
+    int references;
+    AttendeeSet events;
 };
 
-static char *copyString(char *string)
-{
-    char *new_string = malloc(strlen(string) + 1);
-    if (new_string == NULL)
-    {
-        return NULL;
-    }
-    strcpy(new_string, string);
-    return new_string;
-}
-
 Member memberCreate(int id, char *name)
 {
     if (name == NULL)
@@ -35,15 +34,16 @@ Member memberCreate(int id, char *name)
     {
         return NULL;
     }
-    char *new_name = copyString(name);
-    if (new_name == NULL)
+    member->name = internString(name);
+    if (member->name == NULL)
     {
         free(member);
         return NULL;
     }
+    member->events = NULL;
     member->id = id;
-    member->name = new_name;
     member->event_number = 0;
+    member->references = 1;
 
     return member;
 }
@@ -54,7 +54,12 @@ void memberDestroy(Member member)
     {
         return;
     }
-    free(member->name);
+    if (--member->references > 0)
+    {
+        return;
+    }
+    internRelease(member->name);
+    attendeeSetDestroy(member->events);
     free(member);
 }
 
@@ -65,14 +70,8 @@ Member memberCopy(Member member)
         return NULL;
     }
 
-    Member new_member = memberCreate(member->id, member->name);
-    if (new_member == NULL)
-    {
-        return NULL;
-    }
-    new_member->event_number = member->event_number;
-
-    return new_member;
+    member->references++;
+    return member;
 }
 
 char *memberGetName(Member member)
@@ -111,6 +110,62 @@ void memberChangeEventNumber(Member member, int new_event_number)
     member->event_number = new_event_number;
 }
 
+MemberResult memberAddEvent(Member member, int event_id)
+{
+    if (member == NULL)
+    {
+        return MEMBER_NULL_ARGUMENT;
+    }
+    if (event_id < 0)
+    {
+        return MEMBER_INVALID_ID;
+    }
+    if (member->events == NULL)
+    {
+        member->events = attendeeSetCreate();
+        if (member->events == NULL)
+        {
+            return MEMBER_OUT_OF_MEMORY;
+        }
+    }
+
+    switch (attendeeSetAdd(member->events, event_id))
+    {
+    case ATTENDEE_SET_INVALID_ID:
+        return MEMBER_INVALID_ID;
+    case ATTENDEE_SET_ID_ALREADY_EXISTS:
+        return MEMBER_EVENT_ALREADY_EXISTS;
+    case ATTENDEE_SET_OUT_OF_MEMORY:
+        return MEMBER_OUT_OF_MEMORY;
+    default:
+        return MEMBER_SUCCESS;
+    }
+}
+
+MemberResult memberRemoveEvent(Member member, int event_id)
+{
+    if (member == NULL)
+    {
+        return MEMBER_NULL_ARGUMENT;
+    }
+
+    if (member->events == NULL || attendeeSetRemove(member->events, event_id) == ATTENDEE_SET_ID_DOES_NOT_EXIST)
+    {
+        return MEMBER_EVENT_DOES_NOT_EXIST;
+    }
+
+    return MEMBER_SUCCESS;
+}
+
+AttendeeSet memberGetEvents(Member member)
+{
+    if (member == NULL)
+    {
+        return NULL;
+    }
+    return member->events;
+}
+
 bool memberCompare(Member member1, Member member2)
 {
     if(member1 == NULL || member2 == NULL)
@@ -3,6 +3,7 @@
 
 #include <stdbool.h>
 #include <stdio.h>
+#include "attendee_set.h"
 
 /**
 * Member
@@ -11,12 +12,15 @@
 *
 * The following functions are available:
 *   memberCreate                - Allocates a new member.
-*   memberDestroy               - Deallocates an existing member.
-*   memberCopy                  - Creates a copy of target member.
+*   memberDestroy               - Releases a reference to a member.
+*   memberCopy                  - Returns another reference to target member.
 *   memberGetName               - Returns the name of the member.
 *   memberGetId                 - Returns the ID of the member.
 *   memberGetEventNumber        - Returns the number of events that the member has.
 *   memberChangeEventNumber     - Changes the number of events that the member has.
+*   memberAddEvent              - Records that the member attends an event.
+*   memberRemoveEvent           - Records that the member no longer attends an event.
+*   memberGetEvents             - Returns the set of the IDs of the events the member attends.
 *   memberCompare               - Checks if two members are equals.
 *   memberPrint                 - Prints the details of the member.
 */
@@ -24,6 +28,17 @@
 /** Type for defining the member */
 typedef struct Member_t *Member;
 
+/** Type used for returning error codes from member functions */
+typedef enum MemberResult_t
+{
+    MEMBER_SUCCESS,
+    MEMBER_OUT_OF_MEMORY,
+    MEMBER_NULL_ARGUMENT,
+    MEMBER_INVALID_ID,
+    MEMBER_EVENT_ALREADY_EXISTS,
+    MEMBER_EVENT_DOES_NOT_EXIST
+} MemberResult;
+
 /**
 * memberCreate: Allocates a new member.
 *
@@ -37,24 +52,27 @@ typedef struct Member_t *Member;
 Member memberCreate(int id, char *name);
 
 /**
-* memberDestroy: Deallocates an existing event.
+* memberDestroy: Releases a reference to a member, the last one deallocates it.
 *
-* @param member - Target member to be deallocated. If member is NULL nothing will be done.
+* @param member - Target member to be released. If member is NULL nothing will be done.
 */
 void memberDestroy(Member member);
 
 /**
-* memberCopy: Creates a copy of target member.
+* memberCopy: Returns another reference to target member.
+* Members are reference counted, so the copy is the same object as member: changing the
+* event number of one changes the other. The reference must be released with memberDestroy.
 *
 * @param member - Target member.
 * @return
-* 	NULL if a NULL was sent or a memory allocation failed.
-* 	A new member containing the same elements as member otherwise.
+* 	NULL if a NULL was sent.
+* 	member otherwise.
 */
 Member memberCopy(Member member);
 
 /**
 * memberGetName: Returns the name of the member.
+* Names are interned, the returned string is shared and must not be modified.
 * @param member - The member which name is requested.
 * @return
 * 	NULL if a NULL pointer was sent.
@@ -82,12 +100,50 @@ int memberGetEventNumber(Member member);
 
 /**
 * memberChangeEventNumber: Changes the number of events that the member has.
+* The change is seen through every reference to the member.
 * @param member - The member which event number should be changed.
 * @param new_event_number - The new event number for the member.
 *   if NULL is sent nothing happens.
 */
 void memberChangeEventNumber(Member member, int new_event_number);
 
+/**
+* memberAddEvent: Records that the member attends an event, in O(log k) for k events.
+* The event number of the member is not changed.
+*
+* @param member - The member attending the event.
+* @param event_id - The ID of the event.
+* @return
+* 	MEMBER_NULL_ARGUMENT if a NULL was sent as member.
+* 	MEMBER_INVALID_ID if event_id is negative.
+* 	MEMBER_EVENT_ALREADY_EXISTS if the event is already recorded.
+* 	MEMBER_OUT_OF_MEMORY if an allocation failed.
+* 	MEMBER_SUCCESS if the event had been recorded successfully.
+*/
+MemberResult memberAddEvent(Member member, int event_id);
+
+/**
+* memberRemoveEvent: Records that the member no longer attends an event.
+* The event number of the member is not changed.
+*
+* @param member - The member leaving the event.
+* @param event_id - The ID of the event.
+* @return
+* 	MEMBER_NULL_ARGUMENT if a NULL was sent as member.
+* 	MEMBER_EVENT_DOES_NOT_EXIST if the event is not recorded.
+* 	MEMBER_SUCCESS if the event had been removed successfully.
+*/
+MemberResult memberRemoveEvent(Member member, int event_id);
+
+/**
+* memberGetEvents: Returns the set of the IDs of the events the member attends.
+* @param member - The member which events are requested.
+* @return
+* 	NULL if a NULL pointer was sent or the member has never attended an event.
+* 	Otherwise the set of the member, owned by the member. It must not be changed.
+*/
+AttendeeSet memberGetEvents(Member member);
+
 /**
 * memberCompare: Checks if two members are equals.
 *
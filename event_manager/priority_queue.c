@@ -1,14 +1,70 @@
+#define _POSIX_C_SOURCE 200112L
 #include "priority_queue.h"
 #include <stdlib.h>
 #include <assert.h>
 #include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
+#if defined(__unix__) || defined(__APPLE__)
+#define PQ_USE_MMAP
+#define PQ_USE_THREADS
+#include <pthread.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
 #define EXPAND_FACTOR 2
-#define INITIAL_SIZE 10
+#define INLINE_SIZE 8
 #define ELEMENT_NOT_FOUND -1
 #define NULL_ITERATOR -1
 #define NULL_QUEUE -1
+#define FILE_MAGIC "PQUE"
+#define FILE_MAGIC_SIZE 4
+#define FILE_VERSION 1
+#define FILE_BYTE_ORDER 0x01020304
+#define INITIAL_ENCODE_SIZE 64
+#define MIN_PARALLEL_CHUNK 4096
+#define MIN_INDEX_CAPACITY 16
+#define INDEX_LOAD_FACTOR 2
 
-/** Struct representing a Priority Queue implemented as an array */
+/**
+* Header of a serialized priority queue. It is followed by count records of the form
+* [uint32 element size][uint32 priority size][element bytes][priority bytes], highest priority first.
+* Numbers are stored in the writer's byte order, which is checked against byte_order when loading.
+*/
+typedef struct PQFileHeader_t
+{
+    char magic[FILE_MAGIC_SIZE];
+    uint32_t version;
+    uint32_t byte_order;
+    uint32_t reserved;
+    uint64_t count;
+} PQFileHeader;
+
+/** Size of the length fields that precede each record */
+#define RECORD_HEADER_SIZE (2 * sizeof(uint32_t))
+
+/**
+* A slot of the optional key index. element is NULL for an empty slot. priority is the
+* priority stored with element, so its position in the array can be found by binary search.
+*/
+typedef struct PQIndexSlot_t
+{
+    PQElement element;
+    PQElementPriority priority;
+    unsigned int hash;
+} PQIndexSlot;
+
+/**
+* Struct representing a Priority Queue implemented as an array.
+* The first INLINE_SIZE entries are stored inside the struct itself, so creating a small
+* queue costs a single allocation. Once the queue grows past them, both arrays are moved
+* together into one heap block.
+* When a key index is set, index_slots is an open addressing hash table (linear probing,
+* capacity a power of two) holding every element of the queue by the hash of its key.
+*/
 struct PriorityQueue_t
 {
     PQElement *elements;
@@ -24,23 +80,116 @@ struct PriorityQueue_t
     CopyPQElementPriority copy_priority;
     FreePQElementPriority free_priority;
     ComparePQElementPriorities compare_priority;
+
+    PQElement inline_elements[INLINE_SIZE];
+    PQElementPriority inline_priorities[INLINE_SIZE];
+
+    HashPQElementKey hash_element;
+    HashPQKey hash_key;
+    PQIndexSlot *index_slots;
+    int index_capacity;
+
+#ifdef PQ_STATS
+    PQStats stats;
+#endif
 };
 
-static PriorityQueueResult pqRemoveElementByIndex(PriorityQueue queue, int index);
+#ifdef PQ_STATS
+#define PQ_COUNT(queue, counter, amount) ((queue)->stats.counter += (amount))
+#define PQ_UPDATE_PEAK(queue) \
+    ((queue)->stats.peak_size = ((queue)->size > (queue)->stats.peak_size) ? (queue)->size : (queue)->stats.peak_size)
+#else
+#define PQ_COUNT(queue, counter, amount) ((void)0)
+#define PQ_UPDATE_PEAK(queue) ((void)0)
+#endif
+
+static PQElement copyElement(PriorityQueue queue, PQElement element)
+{
+    PQ_COUNT(queue, copy_element, 1);
+    return queue->copy_element(element);
+}
+
+static void freeElement(PriorityQueue queue, PQElement element)
+{
+    PQ_COUNT(queue, free_element, 1);
+    queue->free_element(element);
+}
 
-static PriorityQueueResult addOrDestroy(PriorityQueue pq, PQElement pq_element, PQElementPriority pq_priority);
+static bool equalElements(PriorityQueue queue, PQElement element1, PQElement element2)
+{
+    PQ_COUNT(queue, equal_elements, 1);
+    return queue->equal_elements(element1, element2);
+}
+
+static PQElementPriority copyPriority(PriorityQueue queue, PQElementPriority priority)
+{
+    PQ_COUNT(queue, copy_priority, 1);
+    return queue->copy_priority(priority);
+}
 
-static PriorityQueueResult addAllOrDestroy(PriorityQueue pq, PriorityQueue pq_toAdd);
+static void freePriority(PriorityQueue queue, PQElementPriority priority)
+{
+    PQ_COUNT(queue, free_priority, 1);
+    queue->free_priority(priority);
+}
+
+static int comparePriorities(PriorityQueue queue, PQElementPriority priority1, PQElementPriority priority2)
+{
+    PQ_COUNT(queue, compare_priority, 1);
+    return queue->compare_priority(priority1, priority2);
+}
+
+static bool equalKey(PriorityQueue queue, EqualPQElementKey key_equal, PQElement element, const void *key)
+{
+    PQ_COUNT(queue, equal_key, 1);
+    return key_equal(element, key);
+}
+
+static unsigned int hashElement(PriorityQueue queue, PQElement element)
+{
+    PQ_COUNT(queue, hash, 1);
+    return queue->hash_element(element);
+}
+
+static unsigned int hashKey(PriorityQueue queue, const void *key)
+{
+    PQ_COUNT(queue, hash, 1);
+    return queue->hash_key(key);
+}
+
+static PriorityQueueResult pqRemoveElementByIndex(PriorityQueue queue, int index);
+
+static PriorityQueueResult copyAllOrDestroy(PriorityQueue pq, PriorityQueue pq_toCopy);
 
 static int find(PriorityQueue pq, PQElement element_target);
 
 static int superFind(PriorityQueue pq, PQElement element_target, PQElementPriority priority_target);
 
+static bool isInline(PriorityQueue queue);
+
+static PriorityQueueResult reserve(PriorityQueue queue, int new_size);
+
 static PriorityQueueResult expand(PriorityQueue queue);
 
 static PriorityQueueResult insertToQueueByIndex(PriorityQueue queue,
                                                 int index, PQElement element, PQElementPriority priority);
 
+static PriorityQueueResult indexReserve(PriorityQueue queue, int count);
+
+static void indexAdd(PriorityQueue queue, PQElement element, PQElementPriority priority);
+
+static void indexRemove(PriorityQueue queue, PQElement element);
+
+static PQIndexSlot *indexFind(PriorityQueue queue, const void *key, EqualPQElementKey key_equal);
+
+static PQIndexSlot *indexFindElement(PriorityQueue queue, PQElement element);
+
+static int upperBound(PriorityQueue queue, PQElementPriority priority);
+
+static int lowerBound(PriorityQueue queue, PQElementPriority priority);
+
+static int positionOf(PriorityQueue queue, PQElement element, PQElementPriority priority);
+
 PriorityQueue pqCreate(CopyPQElement copy_element, FreePQElement free_element,
                        EqualPQElements equal_elements, CopyPQElementPriority copy_priority,
                        FreePQElementPriority free_priority, ComparePQElementPriorities compare_priority)
@@ -56,24 +205,12 @@ PriorityQueue pqCreate(CopyPQElement copy_element, FreePQElement free_element,
         return NULL;
     }
 
-    pq->elements = malloc(INITIAL_SIZE * sizeof(PQElement));
-    pq->priorities = malloc(INITIAL_SIZE * sizeof(PQElementPriority));
-
-    if (pq->elements == NULL)
-    {
-        free(pq);
-        return NULL;
-    }
-    if (pq->priorities == NULL)
-    {
-        free(pq);
-        free(pq->elements);
-        return NULL;
-    }
+    pq->elements = pq->inline_elements;
+    pq->priorities = pq->inline_priorities;
 
     pq->size = 0;
     pq->iterator = NULL_ITERATOR;
-    pq->max_size = INITIAL_SIZE;
+    pq->max_size = INLINE_SIZE;
 
     pq->copy_element = copy_element;
     pq->free_element = free_element;
@@ -83,6 +220,15 @@ PriorityQueue pqCreate(CopyPQElement copy_element, FreePQElement free_element,
     pq->free_priority = free_priority;
     pq->compare_priority = compare_priority;
 
+    pq->hash_element = NULL;
+    pq->hash_key = NULL;
+    pq->index_slots = NULL;
+    pq->index_capacity = 0;
+
+#ifdef PQ_STATS
+    pqResetStats(pq);
+#endif
+
     return pq;
 }
 
@@ -92,36 +238,46 @@ void pqDestroy(PriorityQueue queue)
     {
         return;
     }
-    for (int i = 0; i < queue->size; i++)
+    pqClear(queue);
+
+    if (!isInline(queue))
     {
-        pqRemoveElementByIndex(queue, 0);
-        queue->size++;
+        free(queue->elements);
     }
-
-    free(queue->elements);
-    free(queue->priorities);
+    free(queue->index_slots);
     free(queue);
 }
 
-static PriorityQueueResult addOrDestroy(PriorityQueue pq, PQElement pq_element, PQElementPriority pq_priority)
+static PriorityQueueResult copyAllOrDestroy(PriorityQueue pq, PriorityQueue pq_toCopy)
 {
-    PriorityQueueResult result = pqInsert(pq, pq_element, pq_priority);
-    if (result == PQ_OUT_OF_MEMORY)
+    assert(pq != NULL && pq_toCopy != NULL && pq->size == 0);
+    if (reserve(pq, pq_toCopy->size) == PQ_OUT_OF_MEMORY ||
+        indexReserve(pq, pq_toCopy->size) == PQ_OUT_OF_MEMORY)
     {
         pqDestroy(pq);
+        return PQ_OUT_OF_MEMORY;
     }
-    return result;
-}
-
-static PriorityQueueResult addAllOrDestroy(PriorityQueue pq, PriorityQueue pq_toAdd)
-{
-    for (int i = 0; i < pq_toAdd->size; ++i)
+    // the source is already ordered, so the entries are copied as is without comparing them again
+    for (int i = 0; i < pq_toCopy->size; ++i)
     {
-        if (addOrDestroy(pq, pq_toAdd->elements[i], pq_toAdd->priorities[i]) == PQ_OUT_OF_MEMORY)
+        PQElement new_element = copyElement(pq, pq_toCopy->elements[i]);
+        if (new_element == NULL)
+        {
+            pqDestroy(pq);
+            return PQ_OUT_OF_MEMORY;
+        }
+        PQElementPriority new_priority = copyPriority(pq, pq_toCopy->priorities[i]);
+        if (new_priority == NULL)
         {
+            freeElement(pq, new_element);
+            pqDestroy(pq);
             return PQ_OUT_OF_MEMORY;
         }
+        pq->elements[pq->size] = new_element;
+        pq->priorities[pq->size++] = new_priority;
+        indexAdd(pq, new_element, new_priority);
     }
+    PQ_UPDATE_PEAK(pq);
     return PQ_SUCCESS;
 }
 
@@ -139,7 +295,9 @@ PriorityQueue pqCopy(PriorityQueue queue)
     {
         return NULL;
     }
-    if (addAllOrDestroy(new_pq, queue) == PQ_OUT_OF_MEMORY)
+    new_pq->hash_element = queue->hash_element;
+    new_pq->hash_key = queue->hash_key;
+    if (copyAllOrDestroy(new_pq, queue) == PQ_OUT_OF_MEMORY)
     {
         return NULL;
     }
@@ -156,12 +314,21 @@ int pqGetSize(PriorityQueue queue)
     return queue->size;
 }
 
+/**
+* Returns the position of the first element equal to element_target. Uses the key index when
+* there is one, which requires equal elements to have equal keys.
+*/
 static int find(PriorityQueue pq, PQElement element_target)
 {
     assert(pq != NULL && element_target != NULL);
+    if (pq->index_slots != NULL)
+    {
+        PQIndexSlot *slot = indexFindElement(pq, element_target);
+        return slot == NULL ? ELEMENT_NOT_FOUND : positionOf(pq, slot->element, slot->priority);
+    }
     for (int i = 0; i < pq->size; i++)
     {
-        if (pq->equal_elements(pq->elements[i], element_target))
+        if (equalElements(pq, pq->elements[i], element_target))
         {
             return i;
         }
@@ -169,17 +336,16 @@ static int find(PriorityQueue pq, PQElement element_target)
     return ELEMENT_NOT_FOUND;
 }
 
+/** Only the entries of equal priority need to be checked, and they are adjacent in the array */
 static int superFind(PriorityQueue pq, PQElement element_target, PQElementPriority priority_target)
 {
     assert(pq != NULL && element_target != NULL && priority_target != NULL);
-    for (int i = 0; i < pq->size; i++)
+    for (int i = lowerBound(pq, priority_target);
+         i < pq->size && !comparePriorities(pq, pq->priorities[i], priority_target); i++)
     {
-        if (pq->equal_elements(pq->elements[i], element_target))
+        if (equalElements(pq, pq->elements[i], element_target))
         {
-            if (!pq->compare_priority(pq->priorities[i], priority_target))
-            {
-                return i;
-            }
+            return i;
         }
     }
     return ELEMENT_NOT_FOUND;
@@ -207,74 +373,143 @@ PriorityQueueResult pqInsert(PriorityQueue queue, PQElement element,
         return PQ_NULL_ARGUMENT;
     }
     queue->iterator = NULL_ITERATOR;
-    if (queue->size == queue->max_size && expand(queue) == PQ_OUT_OF_MEMORY)
+    if ((queue->size == queue->max_size && expand(queue) == PQ_OUT_OF_MEMORY) ||
+        indexReserve(queue, queue->size + 1) == PQ_OUT_OF_MEMORY)
     {
         return PQ_OUT_OF_MEMORY;
     }
 
-    PQElement new_element = queue->copy_element(element);
+    PQElement new_element = copyElement(queue, element);
     if (new_element == NULL)
     {
         return PQ_OUT_OF_MEMORY;
     }
-    PQElementPriority new_priority = queue->copy_priority(priority);
+    PQElementPriority new_priority = copyPriority(queue, priority);
     if (new_priority == NULL)
     {
-        free(new_element);
+        freeElement(queue, new_element);
         return PQ_OUT_OF_MEMORY;
     }
 
-    for (int i = 0; i < queue->size; i++)
+    indexAdd(queue, new_element, new_priority);
+    return insertToQueueByIndex(queue, upperBound(queue, new_priority), new_element, new_priority);
+}
+
+/**
+* Returns the position of the first entry with a lower priority than the given one, which is
+* where a new entry goes so that it comes after the entries of equal priority.
+* The array is sorted from the highest priority down, so a binary search is enough.
+*/
+static int upperBound(PriorityQueue queue, PQElementPriority priority)
+{
+    int low = 0;
+    int high = queue->size;
+    while (low < high)
     {
-        if (queue->compare_priority(queue->priorities[i], new_priority) < 0)
+        int middle = low + (high - low) / 2;
+        if (comparePriorities(queue, queue->priorities[middle], priority) < 0)
+        {
+            high = middle;
+        }
+        else
         {
-            return insertToQueueByIndex(queue, i, new_element, new_priority);
+            low = middle + 1;
         }
     }
+    return low;
+}
 
-    queue->elements[queue->size] = new_element;
-    queue->priorities[queue->size++] = new_priority;
-    return PQ_SUCCESS;
+/** Returns the position of the first entry with a priority not higher than the given one */
+static int lowerBound(PriorityQueue queue, PQElementPriority priority)
+{
+    int low = 0;
+    int high = queue->size;
+    while (low < high)
+    {
+        int middle = low + (high - low) / 2;
+        if (comparePriorities(queue, queue->priorities[middle], priority) <= 0)
+        {
+            high = middle;
+        }
+        else
+        {
+            low = middle + 1;
+        }
+    }
+    return low;
 }
 
-static PriorityQueueResult expand(PriorityQueue queue)
+/** Returns the position of an element stored in the queue, given the priority stored with it */
+static int positionOf(PriorityQueue queue, PQElement element, PQElementPriority priority)
+{
+    for (int i = lowerBound(queue, priority); i < queue->size; i++)
+    {
+        if (queue->elements[i] == element)
+        {
+            return i;
+        }
+        if (comparePriorities(queue, queue->priorities[i], priority) != 0)
+        {
+            break;
+        }
+    }
+    return ELEMENT_NOT_FOUND;
+}
+
+static bool isInline(PriorityQueue queue)
 {
     assert(queue != NULL);
-    int new_size = EXPAND_FACTOR * queue->max_size;
-    PQElement *new_elements = realloc(queue->elements, new_size * sizeof(PQElement));
+    return queue->elements == queue->inline_elements;
+}
+
+static PriorityQueueResult reserve(PriorityQueue queue, int new_size)
+{
+    assert(queue != NULL);
+    if (new_size <= queue->max_size)
+    {
+        return PQ_SUCCESS;
+    }
+    // elements and priorities share one block: [elements | priorities]
+    PQElement *new_elements = malloc(new_size * (sizeof(PQElement) + sizeof(PQElementPriority)));
     if (new_elements == NULL)
     {
         return PQ_OUT_OF_MEMORY;
     }
-    PQElementPriority *new_priorities = realloc(queue->priorities, new_size * sizeof(PQElementPriority));
-    if (new_priorities == NULL)
+    PQElementPriority *new_priorities = (PQElementPriority *)(new_elements + new_size);
+    memcpy(new_elements, queue->elements, queue->size * sizeof(PQElement));
+    memcpy(new_priorities, queue->priorities, queue->size * sizeof(PQElementPriority));
+
+    if (!isInline(queue))
     {
-        return PQ_OUT_OF_MEMORY;
-        // in this case the user should destroy the queue so we don't free elements.
+        free(queue->elements);
     }
-    queue->priorities = new_priorities;
     queue->elements = new_elements;
+    queue->priorities = new_priorities;
     queue->max_size = new_size;
     return PQ_SUCCESS;
 }
 
+static PriorityQueueResult expand(PriorityQueue queue)
+{
+    assert(queue != NULL);
+    PQ_COUNT(queue, expands, 1);
+    return reserve(queue, EXPAND_FACTOR * queue->max_size);
+}
+
 static PriorityQueueResult insertToQueueByIndex(PriorityQueue queue,
                                                 int index, PQElement element, PQElementPriority priority)
 {
 
-    assert(queue != NULL && index >= 0);
-    queue->size++;
-    if (queue->size == queue->max_size && expand(queue) == PQ_OUT_OF_MEMORY)
-    {
-        return PQ_OUT_OF_MEMORY;
-    }
-    for (int i = queue->size - 1; i > index; i--)
-    {
-        queue->elements[i] = queue->elements[i - 1];
-        queue->priorities[i] = queue->priorities[i - 1];
-    }
+    assert(queue != NULL && index >= 0 && queue->size < queue->max_size);
+    memmove(queue->elements + index + 1, queue->elements + index,
+            (queue->size - index) * sizeof(*queue->elements));
+    memmove(queue->priorities + index + 1, queue->priorities + index,
+            (queue->size - index) * sizeof(*queue->priorities));
+    PQ_COUNT(queue, moves, queue->size - index);
     queue->elements[index] = element;
     queue->priorities[index] = priority;
+    queue->size++;
+    PQ_UPDATE_PEAK(queue);
     return PQ_SUCCESS;
 }
 
@@ -282,14 +517,15 @@ static PriorityQueueResult pqRemoveElementByIndex(PriorityQueue queue, int index
 {
     assert(queue != NULL && index >= 0);
 
-    queue->free_element(queue->elements[index]);
-    queue->free_priority(queue->priorities[index]);
+    indexRemove(queue, queue->elements[index]);
+    freeElement(queue, queue->elements[index]);
+    freePriority(queue, queue->priorities[index]);
 
-    for (int i = index; i < queue->size - 1; i++)
-    {
-        queue->elements[i] = queue->elements[i + 1];
-        queue->priorities[i] = queue->priorities[i + 1];
-    }
+    memmove(queue->elements + index, queue->elements + index + 1,
+            (queue->size - 1 - index) * sizeof(*queue->elements));
+    memmove(queue->priorities + index, queue->priorities + index + 1,
+            (queue->size - 1 - index) * sizeof(*queue->priorities));
+    PQ_COUNT(queue, moves, queue->size - 1 - index);
 
     queue->size--;
     queue->iterator = NULL_ITERATOR;
@@ -321,17 +557,72 @@ PriorityQueueResult pqRemoveElement(PriorityQueue queue, PQElement element)
         return PQ_NULL_ARGUMENT;
     }
     queue->iterator = NULL_ITERATOR;
-    if (!pqContains(queue, element))
+    int index = find(queue, element); // because they are sorted
+                                      // - the biggest priority element exists in the first element
+    if (index == ELEMENT_NOT_FOUND)
     {
         return PQ_ELEMENT_DOES_NOT_EXISTS;
     }
-    int index = find(queue, element); // because they are sorted
-                                      // - the biggest priority element exists in the first element
     return pqRemoveElementByIndex(queue, index);
 }
 
-PriorityQueueResult pqChangePriority(PriorityQueue queue, PQElement element,
-                                     PQElementPriority old_priority, PQElementPriority new_priority)
+int pqRemoveIf(PriorityQueue queue, PQElementPredicate predicate, void *context)
+{
+    if (queue == NULL || predicate == NULL)
+    {
+        return NULL_QUEUE;
+    }
+    queue->iterator = NULL_ITERATOR;
+
+    int kept = 0;
+    for (int i = 0; i < queue->size; i++)
+    {
+        if (predicate(queue->elements[i], queue->priorities[i], context))
+        {
+            indexRemove(queue, queue->elements[i]);
+            freeElement(queue, queue->elements[i]);
+            freePriority(queue, queue->priorities[i]);
+            continue;
+        }
+        if (kept != i)
+        {
+            queue->elements[kept] = queue->elements[i];
+            queue->priorities[kept] = queue->priorities[i];
+            PQ_COUNT(queue, moves, 1);
+        }
+        kept++;
+    }
+
+    int removed = queue->size - kept;
+    queue->size = kept;
+    return removed;
+}
+
+/**
+* Takes the entry at index out of the array and inserts stored with priority_copy at its new
+* place, without any allocation since the size of the queue does not change.
+* The priority of the entry is freed, its element is not.
+*/
+static PriorityQueueResult moveEntry(PriorityQueue queue, int index, PQElement stored,
+                                     PQElementPriority priority_copy)
+{
+    indexRemove(queue, queue->elements[index]);
+    freePriority(queue, queue->priorities[index]);
+    memmove(queue->elements + index, queue->elements + index + 1,
+            (queue->size - 1 - index) * sizeof(*queue->elements));
+    memmove(queue->priorities + index, queue->priorities + index + 1,
+            (queue->size - 1 - index) * sizeof(*queue->priorities));
+    PQ_COUNT(queue, moves, queue->size - 1 - index);
+    queue->size--;
+
+    indexAdd(queue, stored, priority_copy);
+    return insertToQueueByIndex(queue, upperBound(queue, priority_copy), stored, priority_copy);
+}
+
+/** Finds the entry of element with old_priority for pqChangePriority and pqMoveElement */
+static PriorityQueueResult findEntryToMove(PriorityQueue queue, PQElement element,
+                                           PQElementPriority old_priority, PQElementPriority new_priority,
+                                           int *index)
 {
     if (queue == NULL || element == NULL || old_priority == NULL || new_priority == NULL)
     {
@@ -342,17 +633,54 @@ PriorityQueueResult pqChangePriority(PriorityQueue queue, PQElement element,
         return PQ_NULL_ARGUMENT;
     }
     queue->iterator = NULL_ITERATOR;
-    int index = superFind(queue, element, old_priority);
-    if (index == ELEMENT_NOT_FOUND)
+    *index = superFind(queue, element, old_priority);
+    return *index == ELEMENT_NOT_FOUND ? PQ_ELEMENT_DOES_NOT_EXISTS : PQ_SUCCESS;
+}
+
+PriorityQueueResult pqChangePriority(PriorityQueue queue, PQElement element,
+                                     PQElementPriority old_priority, PQElementPriority new_priority)
+{
+    int index;
+    PriorityQueueResult result = findEntryToMove(queue, element, old_priority, new_priority, &index);
+    if (result != PQ_SUCCESS)
     {
-        return PQ_ELEMENT_DOES_NOT_EXISTS;
+        return result;
     }
 
-    PQElement element_tmp = queue->copy_element(element);
-    pqRemoveElementByIndex(queue, index);
-    pqInsert(queue, element_tmp, new_priority);
-    queue->free_element(element_tmp);
-    return PQ_SUCCESS;
+    PQElementPriority priority_copy = copyPriority(queue, new_priority);
+    PQElement element_copy = priority_copy != NULL ? copyElement(queue, element) : NULL;
+    if (element_copy == NULL)
+    {
+        if (priority_copy != NULL)
+        {
+            freePriority(queue, priority_copy);
+        }
+        return PQ_OUT_OF_MEMORY;
+    }
+
+    // the copy of the given element replaces the stored one, as if it was reinserted
+    PQElement stored = queue->elements[index];
+    result = moveEntry(queue, index, element_copy, priority_copy);
+    freeElement(queue, stored);
+    return result;
+}
+
+PriorityQueueResult pqMoveElement(PriorityQueue queue, PQElement element,
+                                  PQElementPriority old_priority, PQElementPriority new_priority)
+{
+    int index;
+    PriorityQueueResult result = findEntryToMove(queue, element, old_priority, new_priority, &index);
+    if (result != PQ_SUCCESS)
+    {
+        return result;
+    }
+
+    PQElementPriority priority_copy = copyPriority(queue, new_priority);
+    if (priority_copy == NULL)
+    {
+        return PQ_OUT_OF_MEMORY;
+    }
+    return moveEntry(queue, index, queue->elements[index], priority_copy);
 }
 
 PriorityQueueResult pqClear(PriorityQueue queue)
@@ -364,33 +692,655 @@ PriorityQueueResult pqClear(PriorityQueue queue)
 
     for (int i = 0; i < queue->size; i++)
     {
-        pqRemoveElementByIndex(queue, 0);
-        queue->size++;
+        freeElement(queue, queue->elements[i]);
+        freePriority(queue, queue->priorities[i]);
     }
 
     queue->size = 0;
+    queue->iterator = NULL_ITERATOR;
+    if (queue->index_slots != NULL)
+    {
+        memset(queue->index_slots, 0, queue->index_capacity * sizeof(*queue->index_slots));
+    }
     return PQ_SUCCESS;
 }
 
 PQElement pqGetFirst(PriorityQueue queue)
 {
-    if (queue == NULL)
+    return pqGetFirstEntry(queue).element;
+}
+
+PQElement pqGetNext(PriorityQueue queue)
+{
+    return pqGetNextEntry(queue).element;
+}
+
+PQEntry pqGetFirstEntry(PriorityQueue queue)
+{
+    if (queue != NULL)
     {
-        return NULL;
+        queue->iterator = 0;
     }
-    queue->iterator = 0;
-    return pqGetNext(queue);
+    return pqGetNextEntry(queue);
 }
 
-PQElement pqGetNext(PriorityQueue queue)
+PQEntry pqGetNextEntry(PriorityQueue queue)
 {
-    if (queue == NULL)
+    PQEntry entry = {NULL, NULL};
+    if (queue == NULL || queue->iterator >= queue->size || queue->iterator < 0)
     {
-        return NULL;
+        return entry;
+    }
+    entry.element = queue->elements[queue->iterator];
+    entry.priority = queue->priorities[queue->iterator++];
+    return entry;
+}
+
+static PriorityQueueResult indexRebuild(PriorityQueue queue, int capacity)
+{
+    assert(queue != NULL && queue->hash_element != NULL);
+    PQIndexSlot *slots = calloc(capacity, sizeof(*slots));
+    if (slots == NULL)
+    {
+        return PQ_OUT_OF_MEMORY;
+    }
+    free(queue->index_slots);
+    queue->index_slots = slots;
+    queue->index_capacity = capacity;
+    for (int i = 0; i < queue->size; i++)
+    {
+        indexAdd(queue, queue->elements[i], queue->priorities[i]);
+    }
+    return PQ_SUCCESS;
+}
+
+/** Makes sure the key index can hold count elements while staying under its load factor */
+static PriorityQueueResult indexReserve(PriorityQueue queue, int count)
+{
+    assert(queue != NULL);
+    if (queue->hash_element == NULL || count * INDEX_LOAD_FACTOR <= queue->index_capacity)
+    {
+        return PQ_SUCCESS;
+    }
+    int capacity = MIN_INDEX_CAPACITY;
+    while (capacity < count * INDEX_LOAD_FACTOR)
+    {
+        capacity *= 2;
     }
-    if (queue->iterator >= queue->size || queue->iterator < 0)
+    return indexRebuild(queue, capacity);
+}
+
+static void indexAdd(PriorityQueue queue, PQElement element, PQElementPriority priority)
+{
+    assert(queue != NULL && element != NULL);
+    if (queue->index_slots == NULL)
+    {
+        return;
+    }
+    unsigned int mask = (unsigned int)queue->index_capacity - 1;
+    unsigned int hash = hashElement(queue, element);
+    unsigned int slot = hash & mask;
+    while (queue->index_slots[slot].element != NULL)
+    {
+        slot = (slot + 1) & mask;
+    }
+    queue->index_slots[slot].element = element;
+    queue->index_slots[slot].priority = priority;
+    queue->index_slots[slot].hash = hash;
+}
+
+/** Removes the element from the key index, shifting back the entries that probed past it */
+static void indexRemove(PriorityQueue queue, PQElement element)
+{
+    assert(queue != NULL && element != NULL);
+    if (queue->index_slots == NULL)
+    {
+        return;
+    }
+    unsigned int mask = (unsigned int)queue->index_capacity - 1;
+    unsigned int slot = hashElement(queue, element) & mask;
+    while (queue->index_slots[slot].element != element)
+    {
+        assert(queue->index_slots[slot].element != NULL);
+        slot = (slot + 1) & mask;
+    }
+
+    unsigned int next = slot;
+    while (true)
+    {
+        next = (next + 1) & mask;
+        if (queue->index_slots[next].element == NULL)
+        {
+            break;
+        }
+        unsigned int home = queue->index_slots[next].hash & mask;
+        // the entry at next may fill the hole only if its home slot is not between the hole and next
+        if (((next - home) & mask) >= ((next - slot) & mask))
+        {
+            queue->index_slots[slot] = queue->index_slots[next];
+            slot = next;
+        }
+    }
+    queue->index_slots[slot].element = NULL;
+}
+
+/**
+* Of two slots of matching entries, returns the one whose entry comes first in the array, which
+* is the one a scan of the array would find. first may be NULL.
+*/
+static PQIndexSlot *firstInArray(PriorityQueue queue, PQIndexSlot *first, PQIndexSlot *slot)
+{
+    if (first == NULL)
+    {
+        return slot;
+    }
+    return positionOf(queue, slot->element, slot->priority) < positionOf(queue, first->element, first->priority)
+               ? slot
+               : first;
+}
+
+/**
+* Returns the slot of the first entry in the array matching key. Entries with equal keys have
+* equal hashes, and backward shift deletion keeps them all before the first empty slot of their
+* probe sequence, so the sequence is walked to its end.
+*/
+static PQIndexSlot *indexFind(PriorityQueue queue, const void *key, EqualPQElementKey key_equal)
+{
+    assert(queue != NULL && queue->index_slots != NULL);
+    unsigned int mask = (unsigned int)queue->index_capacity - 1;
+    unsigned int hash = hashKey(queue, key);
+    PQIndexSlot *first = NULL;
+    for (unsigned int slot = hash & mask; queue->index_slots[slot].element != NULL; slot = (slot + 1) & mask)
+    {
+        if (queue->index_slots[slot].hash == hash &&
+            equalKey(queue, key_equal, queue->index_slots[slot].element, key))
+        {
+            first = firstInArray(queue, first, &queue->index_slots[slot]);
+        }
+    }
+    return first;
+}
+
+/**
+* Returns the slot of the first entry in the array equal to the given element, elements being
+* hashed by their keys. Like indexFind it walks the whole probe sequence.
+*/
+static PQIndexSlot *indexFindElement(PriorityQueue queue, PQElement element)
+{
+    assert(queue != NULL && queue->index_slots != NULL);
+    unsigned int mask = (unsigned int)queue->index_capacity - 1;
+    unsigned int hash = hashElement(queue, element);
+    PQIndexSlot *first = NULL;
+    for (unsigned int slot = hash & mask; queue->index_slots[slot].element != NULL; slot = (slot + 1) & mask)
+    {
+        if (queue->index_slots[slot].hash == hash &&
+            equalElements(queue, queue->index_slots[slot].element, element))
+        {
+            first = firstInArray(queue, first, &queue->index_slots[slot]);
+        }
+    }
+    return first;
+}
+
+PriorityQueueResult pqSetKeyIndex(PriorityQueue queue, HashPQElementKey hash_element, HashPQKey hash_key)
+{
+    if (queue == NULL || (hash_element == NULL) != (hash_key == NULL))
+    {
+        return PQ_NULL_ARGUMENT;
+    }
+    free(queue->index_slots);
+    queue->index_slots = NULL;
+    queue->index_capacity = 0;
+    queue->hash_element = hash_element;
+    queue->hash_key = hash_key;
+    if (hash_element == NULL)
+    {
+        return PQ_SUCCESS;
+    }
+
+    int capacity = MIN_INDEX_CAPACITY;
+    while (capacity < queue->size * INDEX_LOAD_FACTOR)
+    {
+        capacity *= 2;
+    }
+    if (indexRebuild(queue, capacity) == PQ_OUT_OF_MEMORY)
+    {
+        queue->hash_element = NULL;
+        queue->hash_key = NULL;
+        return PQ_OUT_OF_MEMORY;
+    }
+    return PQ_SUCCESS;
+}
+
+static int findBy(PriorityQueue queue, const void *key, EqualPQElementKey key_equal)
+{
+    assert(queue != NULL && key != NULL && key_equal != NULL);
+    for (int i = 0; i < queue->size; i++)
+    {
+        if (equalKey(queue, key_equal, queue->elements[i], key))
+        {
+            return i;
+        }
+    }
+    return ELEMENT_NOT_FOUND;
+}
+
+PQElement pqFindBy(PriorityQueue queue, const void *key, EqualPQElementKey key_equal)
+{
+    if (queue == NULL || key == NULL || key_equal == NULL)
     {
         return NULL;
     }
-    return queue->elements[queue->iterator++];
-}
\ No newline at end of file
+    if (queue->index_slots != NULL)
+    {
+        PQIndexSlot *slot = indexFind(queue, key, key_equal);
+        return slot == NULL ? NULL : slot->element;
+    }
+    int index = findBy(queue, key, key_equal);
+    return index == ELEMENT_NOT_FOUND ? NULL : queue->elements[index];
+}
+
+PriorityQueueResult pqRemoveBy(PriorityQueue queue, const void *key, EqualPQElementKey key_equal)
+{
+    if (queue == NULL || key == NULL || key_equal == NULL)
+    {
+        if (queue != NULL)
+        {
+            queue->iterator = NULL_ITERATOR;
+        }
+        return PQ_NULL_ARGUMENT;
+    }
+    queue->iterator = NULL_ITERATOR;
+
+    int index = ELEMENT_NOT_FOUND;
+    if (queue->index_slots != NULL)
+    {
+        PQIndexSlot *slot = indexFind(queue, key, key_equal);
+        index = slot == NULL ? ELEMENT_NOT_FOUND : positionOf(queue, slot->element, slot->priority);
+    }
+    else
+    {
+        index = findBy(queue, key, key_equal);
+    }
+    if (index == ELEMENT_NOT_FOUND)
+    {
+        return PQ_ELEMENT_DOES_NOT_EXISTS;
+    }
+    return pqRemoveElementByIndex(queue, index);
+}
+
+static void visitRange(PriorityQueue queue, int begin, int end, PQVisitor visitor, void *context)
+{
+    for (int i = begin; i < end; i++)
+    {
+        visitor(queue->elements[i], queue->priorities[i], i, context);
+    }
+}
+
+PriorityQueueResult pqForEach(PriorityQueue queue, PQVisitor visitor, void *context)
+{
+    if (queue == NULL || visitor == NULL)
+    {
+        return PQ_NULL_ARGUMENT;
+    }
+    visitRange(queue, 0, queue->size, visitor, context);
+    return PQ_SUCCESS;
+}
+
+#ifdef PQ_USE_THREADS
+/** A contiguous part of the queue visited by a single thread */
+typedef struct PQChunk_t
+{
+    PriorityQueue queue;
+    int begin;
+    int end;
+    PQVisitor visitor;
+    void *context;
+} PQChunk;
+
+static void *visitChunk(void *chunk_ptr)
+{
+    PQChunk *chunk = chunk_ptr;
+    visitRange(chunk->queue, chunk->begin, chunk->end, chunk->visitor, chunk->context);
+    return NULL;
+}
+#endif
+
+PriorityQueueResult pqParallelForEach(PriorityQueue queue, PQVisitor visitor, void *context, int thread_count)
+{
+    if (queue == NULL || visitor == NULL)
+    {
+        return PQ_NULL_ARGUMENT;
+    }
+#ifdef PQ_USE_THREADS
+    int max_chunks = (queue->size + MIN_PARALLEL_CHUNK - 1) / MIN_PARALLEL_CHUNK;
+    int chunk_count = thread_count < max_chunks ? thread_count : max_chunks;
+    PQChunk *chunks = chunk_count > 1 ? malloc(chunk_count * sizeof(*chunks)) : NULL;
+    pthread_t *threads = chunk_count > 1 ? malloc(chunk_count * sizeof(*threads)) : NULL;
+    bool *started = chunk_count > 1 ? calloc(chunk_count, sizeof(*started)) : NULL;
+    if (chunks == NULL || threads == NULL || started == NULL)
+    {
+        free(chunks);
+        free(threads);
+        free(started);
+        return pqForEach(queue, visitor, context);
+    }
+
+    for (int i = 0; i < chunk_count; i++)
+    {
+        chunks[i].queue = queue;
+        chunks[i].begin = (int)((long long)queue->size * i / chunk_count);
+        chunks[i].end = (int)((long long)queue->size * (i + 1) / chunk_count);
+        chunks[i].visitor = visitor;
+        chunks[i].context = context;
+    }
+    // the first chunk runs on the calling thread, and so does any chunk whose thread failed to start
+    for (int i = 1; i < chunk_count; i++)
+    {
+        started[i] = pthread_create(&threads[i], NULL, visitChunk, &chunks[i]) == 0;
+    }
+    visitChunk(&chunks[0]);
+    for (int i = 1; i < chunk_count; i++)
+    {
+        if (started[i])
+        {
+            pthread_join(threads[i], NULL);
+        }
+        else
+        {
+            visitChunk(&chunks[i]);
+        }
+    }
+
+    free(chunks);
+    free(threads);
+    free(started);
+    return PQ_SUCCESS;
+#else
+    (void)thread_count;
+    return pqForEach(queue, visitor, context);
+#endif
+}
+
+static PriorityQueueResult encodeToBuffer(EncodePQElement encode, void *item,
+                                          unsigned char **buffer, size_t *capacity, uint32_t *size)
+{
+    size_t encoded_size = encode(item, *buffer, *capacity);
+    if (encoded_size > *capacity)
+    {
+        unsigned char *new_buffer = realloc(*buffer, encoded_size);
+        if (new_buffer == NULL)
+        {
+            return PQ_OUT_OF_MEMORY;
+        }
+        *buffer = new_buffer;
+        *capacity = encoded_size;
+        encoded_size = encode(item, *buffer, *capacity);
+    }
+    if (encoded_size > *capacity || encoded_size > UINT32_MAX)
+    {
+        return PQ_ERROR;
+    }
+    *size = (uint32_t)encoded_size;
+    return PQ_SUCCESS;
+}
+
+static PriorityQueueResult writeEntries(PriorityQueue queue, FILE *file,
+                                        EncodePQElement encode_element, EncodePQElementPriority encode_priority)
+{
+    size_t element_capacity = INITIAL_ENCODE_SIZE;
+    size_t priority_capacity = INITIAL_ENCODE_SIZE;
+    unsigned char *element_buffer = malloc(element_capacity);
+    unsigned char *priority_buffer = malloc(priority_capacity);
+    PriorityQueueResult result = PQ_SUCCESS;
+    if (element_buffer == NULL || priority_buffer == NULL)
+    {
+        result = PQ_OUT_OF_MEMORY;
+    }
+
+    for (int i = 0; i < queue->size && result == PQ_SUCCESS; i++)
+    {
+        uint32_t sizes[2];
+        result = encodeToBuffer(encode_element, queue->elements[i], &element_buffer, &element_capacity, &sizes[0]);
+        if (result == PQ_SUCCESS)
+        {
+            result = encodeToBuffer(encode_priority, queue->priorities[i],
+                                    &priority_buffer, &priority_capacity, &sizes[1]);
+        }
+        if (result == PQ_SUCCESS &&
+            (fwrite(sizes, sizeof(sizes), 1, file) != 1 ||
+             fwrite(element_buffer, 1, sizes[0], file) != sizes[0] ||
+             fwrite(priority_buffer, 1, sizes[1], file) != sizes[1]))
+        {
+            result = PQ_FILE_ERROR;
+        }
+    }
+
+    free(element_buffer);
+    free(priority_buffer);
+    return result;
+}
+
+PriorityQueueResult pqSerialize(PriorityQueue queue, const char *file_name,
+                                EncodePQElement encode_element, EncodePQElementPriority encode_priority)
+{
+    if (queue == NULL || file_name == NULL || encode_element == NULL || encode_priority == NULL)
+    {
+        return PQ_NULL_ARGUMENT;
+    }
+    queue->iterator = NULL_ITERATOR;
+
+    FILE *file = fopen(file_name, "wb");
+    if (file == NULL)
+    {
+        return PQ_FILE_ERROR;
+    }
+
+    PQFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, FILE_MAGIC, FILE_MAGIC_SIZE);
+    header.version = FILE_VERSION;
+    header.byte_order = FILE_BYTE_ORDER;
+    header.count = (uint64_t)queue->size;
+
+    PriorityQueueResult result = PQ_FILE_ERROR;
+    if (fwrite(&header, sizeof(header), 1, file) == 1)
+    {
+        result = writeEntries(queue, file, encode_element, encode_priority);
+    }
+    if (fclose(file) != 0 && result == PQ_SUCCESS)
+    {
+        result = PQ_FILE_ERROR;
+    }
+    return result;
+}
+
+/**
+* Maps the whole file into memory for reading. Where mmap is not available the file is read
+* into a heap buffer instead. The data must be released with unmapFile.
+*/
+static PriorityQueueResult mapFile(const char *file_name, const unsigned char **data, size_t *size)
+{
+#ifdef PQ_USE_MMAP
+    int fd = open(file_name, O_RDONLY);
+    if (fd < 0)
+    {
+        return PQ_FILE_ERROR;
+    }
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0)
+    {
+        close(fd);
+        return PQ_FILE_ERROR;
+    }
+    if ((size_t)file_stat.st_size < sizeof(PQFileHeader))
+    {
+        close(fd);
+        return PQ_INVALID_FORMAT;
+    }
+    void *mapped = mmap(NULL, (size_t)file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED)
+    {
+        return PQ_FILE_ERROR;
+    }
+    posix_madvise(mapped, (size_t)file_stat.st_size, POSIX_MADV_SEQUENTIAL);
+    *data = mapped;
+    *size = (size_t)file_stat.st_size;
+    return PQ_SUCCESS;
+#else
+    FILE *file = fopen(file_name, "rb");
+    if (file == NULL)
+    {
+        return PQ_FILE_ERROR;
+    }
+    long file_size = -1;
+    if (fseek(file, 0L, SEEK_END) == 0)
+    {
+        file_size = ftell(file);
+    }
+    if (file_size < 0 || fseek(file, 0L, SEEK_SET) != 0)
+    {
+        fclose(file);
+        return PQ_FILE_ERROR;
+    }
+    if ((size_t)file_size < sizeof(PQFileHeader))
+    {
+        fclose(file);
+        return PQ_INVALID_FORMAT;
+    }
+    unsigned char *buffer = malloc((size_t)file_size);
+    if (buffer == NULL)
+    {
+        fclose(file);
+        return PQ_OUT_OF_MEMORY;
+    }
+    if (fread(buffer, 1, (size_t)file_size, file) != (size_t)file_size)
+    {
+        free(buffer);
+        fclose(file);
+        return PQ_FILE_ERROR;
+    }
+    fclose(file);
+    *data = buffer;
+    *size = (size_t)file_size;
+    return PQ_SUCCESS;
+#endif
+}
+
+static void unmapFile(const unsigned char *data, size_t size)
+{
+#ifdef PQ_USE_MMAP
+    munmap((void *)data, size);
+#else
+    free((void *)data);
+#endif
+}
+
+static PriorityQueueResult loadEntries(PriorityQueue queue, const unsigned char *data, size_t size,
+                                       DecodePQElement decode_element, DecodePQElementPriority decode_priority)
+{
+    assert(queue != NULL && data != NULL && size >= sizeof(PQFileHeader));
+    PQFileHeader header;
+    memcpy(&header, data, sizeof(header));
+    size_t offset = sizeof(header);
+    if (memcmp(header.magic, FILE_MAGIC, FILE_MAGIC_SIZE) != 0 || header.version != FILE_VERSION ||
+        header.byte_order != FILE_BYTE_ORDER || header.count > INT_MAX ||
+        header.count > (size - offset) / RECORD_HEADER_SIZE)
+    {
+        return PQ_INVALID_FORMAT;
+    }
+    if (reserve(queue, (int)header.count) == PQ_OUT_OF_MEMORY ||
+        indexReserve(queue, (int)header.count) == PQ_OUT_OF_MEMORY)
+    {
+        return PQ_OUT_OF_MEMORY;
+    }
+
+    // the records are already in the queue's order, so they are appended without comparing
+    for (uint64_t i = 0; i < header.count; i++)
+    {
+        uint32_t sizes[2];
+        if (size - offset < RECORD_HEADER_SIZE)
+        {
+            return PQ_INVALID_FORMAT;
+        }
+        memcpy(sizes, data + offset, sizeof(sizes));
+        offset += RECORD_HEADER_SIZE;
+        if (size - offset < (size_t)sizes[0] + sizes[1])
+        {
+            return PQ_INVALID_FORMAT;
+        }
+
+        PQElement element = decode_element(data + offset, sizes[0]);
+        if (element == NULL)
+        {
+            return PQ_OUT_OF_MEMORY;
+        }
+        offset += sizes[0];
+        PQElementPriority priority = decode_priority(data + offset, sizes[1]);
+        if (priority == NULL)
+        {
+            freeElement(queue, element);
+            return PQ_OUT_OF_MEMORY;
+        }
+        offset += sizes[1];
+
+        queue->elements[queue->size] = element;
+        queue->priorities[queue->size++] = priority;
+        indexAdd(queue, element, priority);
+    }
+    PQ_UPDATE_PEAK(queue);
+    return offset == size ? PQ_SUCCESS : PQ_INVALID_FORMAT;
+}
+
+PriorityQueueResult pqDeserialize(PriorityQueue queue, const char *file_name,
+                                  DecodePQElement decode_element, DecodePQElementPriority decode_priority)
+{
+    if (queue == NULL || file_name == NULL || decode_element == NULL || decode_priority == NULL)
+    {
+        return PQ_NULL_ARGUMENT;
+    }
+    queue->iterator = NULL_ITERATOR;
+    if (queue->size != 0)
+    {
+        return PQ_ERROR;
+    }
+
+    const unsigned char *data = NULL;
+    size_t size = 0;
+    PriorityQueueResult result = mapFile(file_name, &data, &size);
+    if (result != PQ_SUCCESS)
+    {
+        return result;
+    }
+    result = loadEntries(queue, data, size, decode_element, decode_priority);
+    unmapFile(data, size);
+    if (result != PQ_SUCCESS)
+    {
+        pqClear(queue);
+    }
+    return result;
+}
+
+#ifdef PQ_STATS
+PriorityQueueResult pqGetStats(PriorityQueue queue, PQStats *stats)
+{
+    if (queue == NULL || stats == NULL)
+    {
+        return PQ_NULL_ARGUMENT;
+    }
+    *stats = queue->stats;
+    return PQ_SUCCESS;
+}
+
+PriorityQueueResult pqResetStats(PriorityQueue queue)
+{
+    if (queue == NULL)
+    {
+        return PQ_NULL_ARGUMENT;
+    }
+    memset(&queue->stats, 0, sizeof(queue->stats));
+    queue->stats.peak_size = queue->size;
+    return PQ_SUCCESS;
+}
+#endif
\ No newline at end of file
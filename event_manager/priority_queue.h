@@ -2,6 +2,7 @@
 #define PRIORITY_QUEUE_H
 
 #include <stdbool.h>
+#include <stddef.h>
 
 /**
 * Generic Priority Queue Container
@@ -22,13 +23,28 @@
 *   				        Iterator value is undefined after this operation.
 *   pqChangePriority  	- Changes priority of an element with specific priority
 *					        Iterator value is undefined after this operation.
+*   pqMoveElement       - Like pqChangePriority, but keeps the stored element instead of a copy.
+*					        Iterator value is undefined after this operation.
 *   pqRemove		    - Removes the highest priority element in the queue
 *                           Iterator value is undefined after this operation.
+*   pqRemoveIf          - Removes every element matching a predicate in a single pass.
 *   pqGetFirst	        - Sets the internal iterator to the first element in the priority queue and returns it
 *   pqGetNext		    - Advances the internal iterator to the next key and returns it.
+*   pqGetFirstEntry     - Like pqGetFirst, but returns the element together with its priority.
+*   pqGetNextEntry      - Like pqGetNext, but returns the element together with its priority.
 *	pqClear		        - Clears the contents of the priority queue. Frees all the elements of
 *	 				        the queue using the free function.
+*   pqSerialize         - Writes the priority queue, in order, to a binary file.
+*   pqDeserialize       - Loads a priority queue written by pqSerialize without re-comparing priorities.
+*   pqGetStats          - Returns the operation counters of the priority queue (PQ_STATS builds only).
+*   pqResetStats        - Resets the operation counters of the priority queue (PQ_STATS builds only).
+*   pqFindBy            - Returns the element matching a lookup key, without building a dummy element.
+*   pqRemoveBy          - Removes the element matching a lookup key.
+*   pqSetKeyIndex       - Maintains a hash index of the elements by key, making pqFindBy O(1).
+*   pqForEach           - Calls a function on every element in order, without using the internal iterator.
+*   pqParallelForEach   - Calls a read-only function on every element, splitting the queue between threads.
 * 	PQ_FOREACH	        - A macro for iterating over the priority queue's elements.
+* 	PQ_FOREACH_ENTRY    - A macro for iterating over the priority queue's elements and priorities.
 */
 
 /** Type for defining the priority queue */
@@ -42,6 +58,8 @@ typedef enum PriorityQueueResult_t
     PQ_NULL_ARGUMENT,
     PQ_ELEMENT_DOES_NOT_EXISTS,
     PQ_ITEM_DOES_NOT_EXIST,
+    PQ_FILE_ERROR,
+    PQ_INVALID_FORMAT,
     PQ_ERROR
 } PriorityQueueResult;
 
@@ -51,6 +69,13 @@ typedef void *PQElement;
 /** priority data type for priority queue container */
 typedef void *PQElementPriority;
 
+/** An element of the priority queue together with the priority stored for it */
+typedef struct PQEntry_t
+{
+    PQElement element;
+    PQElementPriority priority;
+} PQEntry;
+
 /** Type of function for copying a data element of the priority queue */
 typedef PQElement (*CopyPQElement)(PQElement);
 
@@ -80,6 +105,60 @@ typedef bool (*EqualPQElements)(PQElement, PQElement);
 */
 typedef int (*ComparePQElementPriorities)(PQElementPriority, PQElementPriority);
 
+/**
+* Type of function used by pqFindBy and pqRemoveBy to match an element against a lookup key
+* (for example an id). This function should return:
+* 		true if the element has the given key;
+*		false otherwise;
+*/
+typedef bool (*EqualPQElementKey)(PQElement element, const void *key);
+
+/**
+* Type of function returning the hash of an element's key for the key index.
+* It must equal the HashPQKey of the key the element matches, and must not change while
+* the element is in the priority queue.
+*/
+typedef unsigned int (*HashPQElementKey)(PQElement element);
+
+/** Type of function returning the hash of a lookup key for the key index */
+typedef unsigned int (*HashPQKey)(const void *key);
+
+/**
+* Type of function used by pqRemoveIf to select the entries to remove.
+* context is passed as is from the caller. This function should return:
+* 		true if the entry should be removed;
+*		false otherwise;
+*/
+typedef bool (*PQElementPredicate)(PQElement element, PQElementPriority priority, void *context);
+
+/**
+* Type of function applied to the entries of the priority queue by pqForEach and pqParallelForEach.
+* index is the position of the entry in the queue's order, 0 being the highest priority.
+* context is passed as is from the caller.
+*/
+typedef void (*PQVisitor)(PQElement element, PQElementPriority priority, int index, void *context);
+
+/**
+* Type of function for encoding a data element into a buffer when serializing the priority queue.
+* The function writes at most buffer_size bytes into buffer and returns the number of bytes
+* the encoding requires. If that number is bigger than buffer_size, the function will be called
+* again with a buffer large enough.
+*/
+typedef size_t (*EncodePQElement)(PQElement, void *buffer, size_t buffer_size);
+
+/** Type of function for encoding a priority into a buffer, same contract as EncodePQElement */
+typedef size_t (*EncodePQElementPriority)(PQElementPriority, void *buffer, size_t buffer_size);
+
+/**
+* Type of function for decoding a data element written by EncodePQElement.
+* The buffer is not aligned. The function returns a newly allocated element which is
+* then owned by the priority queue, or NULL if the allocation failed.
+*/
+typedef PQElement (*DecodePQElement)(const void *buffer, size_t size);
+
+/** Type of function for decoding a priority written by EncodePQElementPriority */
+typedef PQElementPriority (*DecodePQElementPriority)(const void *buffer, size_t size);
+
 /**
 * pqCreate: Allocates a new empty priority queue.
 *
@@ -170,7 +249,8 @@ PriorityQueueResult pqInsert(PriorityQueue queue, PQElement element, PQElementPr
 *	pqChangePriority: Changes a priority of specific element with a specific priority in the priority queue.
 *           If there are multiple same elements with same priority,
 *           only the first element's priority needs to be changed.
-*           Element that its value has changed is considered as reinserted element.
+*           Element that its value has changed is considered as reinserted element:
+*           a copy of the given element replaces the stored one.
 *			Iterator's value is undefined after this operation
 *
 * @param queue - The priority queue for which the element from.
@@ -180,13 +260,33 @@ PriorityQueueResult pqInsert(PriorityQueue queue, PQElement element, PQElementPr
 * @return
 * 	PQ_NULL_ARGUMENT if a NULL was sent as one of the parameters
 * 	PQ_OUT_OF_MEMORY if an allocation failed (Meaning the function for copying
-* 	an element failed)
+* 	an element or the new priority failed), the queue is then unchanged.
 * 	PQ_ELEMENT_DOES_NOT_EXISTS if element with old_priority does not exists in the queue.
 * 	PQ_SUCCESS the paired elements had been inserted successfully
 */
 PriorityQueueResult pqChangePriority(PriorityQueue queue, PQElement element,
                                      PQElementPriority old_priority, PQElementPriority new_priority);
 
+/**
+*	pqMoveElement: Changes a priority of specific element with a specific priority in the priority queue,
+*           like pqChangePriority, but the stored element is moved to its new place instead of being
+*           replaced by a copy of the given one. It stays the same object, and only the new priority
+*           is copied.
+*			Iterator's value is undefined after this operation
+*
+* @param queue - The priority queue for which the element from.
+* @param element - The element which need to be found and whos priority we want to change.
+* @param old_priority - The old priority of the element which need to be changed.
+* @param new_priority - The new priority of the element.
+* @return
+* 	PQ_NULL_ARGUMENT if a NULL was sent as one of the parameters
+* 	PQ_OUT_OF_MEMORY if copying the new priority failed, the queue is then unchanged.
+* 	PQ_ELEMENT_DOES_NOT_EXISTS if element with old_priority does not exists in the queue.
+* 	PQ_SUCCESS the element had been moved successfully
+*/
+PriorityQueueResult pqMoveElement(PriorityQueue queue, PQElement element,
+                                  PQElementPriority old_priority, PQElementPriority new_priority);
+
 /**
 *   pqRemove: Removes the highest priority element from the priority queue.
 *   If there are multiple elements with the same highest priority, the first inserted element should be removed first.
@@ -211,6 +311,8 @@ PriorityQueueResult pqRemove(PriorityQueue queue);
 * 	The element to find and remove from the priority queue. The element will be freed using the
 * 	free function given at initialization. The priority associated with this element
 *   will also be freed using the free function given at initialization.
+*   The queue keeps its capacity, so inserting an element right after removing one only
+*   allocates through the copying functions given at initialization.
 * @return
 * 	PQ_NULL_ARGUMENT if a NULL was sent to the function.
 * 	PQ_ELEMENT_DOES_NOT_EXISTS if given element does not exists.
@@ -218,6 +320,23 @@ PriorityQueueResult pqRemove(PriorityQueue queue);
 */
 PriorityQueueResult pqRemoveElement(PriorityQueue queue, PQElement element);
 
+/**
+*   pqRemoveIf: Removes every element for which predicate returns true, keeping the order of the
+*   remaining elements. The queue is compacted in a single pass, so the whole operation is linear
+*   in the size of the queue. predicate is called once per element, in the queue's order, and must
+*   not modify the queue. The removed elements and their priorities are deallocated using the free
+*   functions supplied at initialization.
+*   Iterator's value is undefined after this operation.
+*
+* @param queue - The priority queue to remove the elements from.
+* @param predicate - Function deciding which entries to remove.
+* @param context - Passed as is to every call of predicate.
+* @return
+* 	-1 if a NULL was sent as queue or predicate.
+* 	Otherwise the number of elements removed.
+*/
+int pqRemoveIf(PriorityQueue queue, PQElementPredicate predicate, void *context);
+
 /**
 *	pqGetFirst: Sets the internal iterator (also called current element) to
 *	the first element in the priority queue. The internal order derived from the priorities, and the tie-breaker between
@@ -243,6 +362,30 @@ PQElement pqGetFirst(PriorityQueue queue);
 */
 PQElement pqGetNext(PriorityQueue queue);
 
+/**
+*	pqGetFirstEntry: Sets the internal iterator to the first element in the priority queue, and
+*	returns it together with its priority. Both remain owned by the priority queue.
+*	To continue iteration use pqGetNextEntry (or pqGetNext).
+*
+* @param queue - The priority queue for which to set the iterator and return the first entry.
+* @return
+* 	An entry with NULL element and priority if a NULL pointer was sent or the priority queue is empty.
+* 	The first element of the priority queue and its priority otherwise.
+*/
+PQEntry pqGetFirstEntry(PriorityQueue queue);
+
+/**
+*	pqGetNextEntry: Advances the priority queue iterator to the next element, and returns it
+*	together with its priority.
+*
+* @param queue - The priority queue for which to advance the iterator.
+* @return
+* 	An entry with NULL element and priority if reached the end of the priority queue, or the
+* 	iterator is at an invalid state or a NULL sent as argument.
+* 	The next element on the priority queue and its priority in case of success.
+*/
+PQEntry pqGetNextEntry(PriorityQueue queue);
+
 /**
 * pqClear: Removes all elements and priorities from target priority queue.
 * The elements are deallocated using the stored free functions.
@@ -254,6 +397,174 @@ PQElement pqGetNext(PriorityQueue queue);
 */
 PriorityQueueResult pqClear(PriorityQueue queue);
 
+/**
+* pqFindBy: Returns the highest priority element matching a lookup key, as decided by key_equal.
+* If several elements have the highest priority, the first inserted one is returned.
+* When a key index is set (see pqSetKeyIndex) the lookup takes O(1) on average, plus a binary
+* search for each element sharing the key when there are several.
+* The internal iterator is not changed.
+*
+* @param queue - The priority queue to search in.
+* @param key - The key to look for, passed as is to key_equal.
+* @param key_equal - Function matching an element against key.
+* @return
+* 	NULL if a NULL was sent as one of the parameters or no element matches the key.
+* 	The matching element otherwise. It remains owned by the priority queue.
+*/
+PQElement pqFindBy(PriorityQueue queue, const void *key, EqualPQElementKey key_equal);
+
+/**
+* pqRemoveBy: Removes the element pqFindBy would return for the same key.
+* The element and its priority are freed using the free functions given at initialization.
+* Iterator's value is undefined after this operation.
+*
+* @param queue - The priority queue to remove the element from.
+* @param key - The key to look for, passed as is to key_equal.
+* @param key_equal - Function matching an element against key.
+* @return
+* 	PQ_NULL_ARGUMENT if a NULL was sent as one of the parameters.
+* 	PQ_ELEMENT_DOES_NOT_EXISTS if no element matches the key.
+* 	PQ_SUCCESS the element had been removed successfully.
+*/
+PriorityQueueResult pqRemoveBy(PriorityQueue queue, const void *key, EqualPQElementKey key_equal);
+
+/**
+* pqSetKeyIndex: Makes the priority queue maintain a hash index of its elements by key, which
+* pqFindBy and pqRemoveBy then use instead of scanning. The index is kept up to date by every
+* function that adds or removes elements, and is inherited by pqCopy.
+* pqContains and pqRemoveElement use the index as well, so elements that are equal by the
+* equality function given at initialization must have equal key hashes. Elements may share a
+* key, every function finds the same element among them with or without the index.
+* Sending NULL as both hash functions removes the index.
+*
+* @param queue - The priority queue to index.
+* @param hash_element - Returns the hash of an element's key.
+* @param hash_key - Returns the hash of a lookup key, consistent with hash_element.
+* @return
+* 	PQ_NULL_ARGUMENT if queue is NULL or only one of the hash functions is NULL.
+* 	PQ_OUT_OF_MEMORY if an allocation failed, in which case the queue has no index.
+* 	PQ_SUCCESS otherwise.
+*/
+PriorityQueueResult pqSetKeyIndex(PriorityQueue queue, HashPQElementKey hash_element, HashPQKey hash_key);
+
+/**
+* pqForEach: Calls visitor on every element and its priority, in the queue's order.
+* The internal iterator is neither used nor changed. The visitor must not modify the queue.
+*
+* @param queue - The priority queue to walk.
+* @param visitor - The function to call on every entry.
+* @param context - Passed as is to every call of visitor.
+* @return
+* 	PQ_NULL_ARGUMENT if a NULL was sent as queue or visitor.
+* 	PQ_SUCCESS otherwise.
+*/
+PriorityQueueResult pqForEach(PriorityQueue queue, PQVisitor visitor, void *context);
+
+/**
+* pqParallelForEach: Calls visitor on every element and its priority, splitting the queue into
+* contiguous chunks that are visited concurrently by up to thread_count threads.
+* The order in which entries are visited is unspecified, use the index argument to tell them apart.
+* The visitor must not modify the queue or its entries, and must be safe to call concurrently
+* with the same context (for example by writing only to slots selected by index).
+* Small queues, or platforms without threads, are visited on the calling thread.
+* The internal iterator is neither used nor changed.
+*
+* @param queue - The priority queue to walk.
+* @param visitor - The function to call on every entry.
+* @param context - Passed as is to every call of visitor.
+* @param thread_count - The maximal number of threads to use, including the calling thread.
+* @return
+* 	PQ_NULL_ARGUMENT if a NULL was sent as queue or visitor.
+* 	PQ_SUCCESS otherwise.
+*/
+PriorityQueueResult pqParallelForEach(PriorityQueue queue, PQVisitor visitor, void *context, int thread_count);
+
+/**
+* pqSerialize: Writes all the elements and priorities of the priority queue, in the queue's order,
+* to a versioned binary file. The file can be loaded back with pqDeserialize.
+* Iterator's value is undefined after this operation.
+*
+* @param queue - The priority queue to write.
+* @param file_name - The path of the file to create or overwrite.
+* @param encode_element - Function used to encode every data element.
+* @param encode_priority - Function used to encode every priority.
+* @return
+* 	PQ_NULL_ARGUMENT if a NULL was sent as one of the parameters.
+* 	PQ_OUT_OF_MEMORY if an allocation failed.
+* 	PQ_FILE_ERROR if the file could not be opened or written.
+* 	PQ_SUCCESS the priority queue had been written successfully.
+*/
+PriorityQueueResult pqSerialize(PriorityQueue queue, const char *file_name,
+                                EncodePQElement encode_element, EncodePQElementPriority encode_priority);
+
+/**
+* pqDeserialize: Loads a file written by pqSerialize into an empty priority queue.
+* The file is memory mapped where the platform allows it, and since it is already in order the
+* queue is built in a single pass without calling the compare or copy functions.
+* The decoded elements and priorities are owned by the queue and freed with its free functions.
+* Iterator's value is undefined after this operation.
+*
+* @param queue - An empty priority queue, created with the functions matching the file's content.
+* @param file_name - The path of the file to load.
+* @param decode_element - Function used to decode every data element.
+* @param decode_priority - Function used to decode every priority.
+* @return
+* 	PQ_NULL_ARGUMENT if a NULL was sent as one of the parameters.
+* 	PQ_ERROR if the priority queue is not empty.
+* 	PQ_FILE_ERROR if the file could not be opened or read.
+* 	PQ_INVALID_FORMAT if the file is not a priority queue file of a supported version.
+* 	PQ_OUT_OF_MEMORY if an allocation failed.
+* 	PQ_SUCCESS the priority queue had been loaded successfully.
+* 	On failure the priority queue is left empty.
+*/
+PriorityQueueResult pqDeserialize(PriorityQueue queue, const char *file_name,
+                                  DecodePQElement decode_element, DecodePQElementPriority decode_priority);
+
+#ifdef PQ_STATS
+/**
+* Operation counters kept per priority queue when the library is built with PQ_STATS.
+* Every invocation of a user callback is counted, as well as the number of entries
+* shifted inside the arrays, the number of times the arrays had to grow and the
+* largest size the queue reached since creation or the last reset.
+*/
+typedef struct PQStats_t
+{
+    long compare_priority;
+    long equal_elements;
+    long copy_element;
+    long free_element;
+    long copy_priority;
+    long free_priority;
+    long equal_key;
+    long hash;
+    long moves;
+    long expands;
+    int peak_size;
+} PQStats;
+
+/**
+* pqGetStats: Returns the operation counters of the priority queue.
+*
+* @param queue - The priority queue which counters are requested.
+* @param stats - Pointer to assign the counters into.
+* @return
+* 	PQ_NULL_ARGUMENT if a NULL was sent as one of the parameters.
+* 	PQ_SUCCESS the counters had been assigned successfully.
+*/
+PriorityQueueResult pqGetStats(PriorityQueue queue, PQStats *stats);
+
+/**
+* pqResetStats: Resets the operation counters of the priority queue.
+* The peak size restarts from the current size of the queue.
+*
+* @param queue - The priority queue which counters should be reset.
+* @return
+* 	PQ_NULL_ARGUMENT if a NULL was sent.
+* 	PQ_SUCCESS otherwise.
+*/
+PriorityQueueResult pqResetStats(PriorityQueue queue);
+#endif
+
 /*!
 * Macro for iterating over a priority queue.
 * Declares a new iterator for the loop.
@@ -263,4 +574,13 @@ PriorityQueueResult pqClear(PriorityQueue queue);
          iterator;                                \
          iterator = pqGetNext(queue))
 
+/*!
+* Macro for iterating over a priority queue's elements together with their priorities.
+* Declares a new PQEntry for the loop.
+*/
+#define PQ_FOREACH_ENTRY(entry, queue)                  \
+    for (PQEntry entry = pqGetFirstEntry(queue);        \
+         entry.element;                                 \
+         entry = pqGetNextEntry(queue))
+
 #endif /* PRIORITY_QUEUE_H_ */
@@ -0,0 +1,375 @@
+#include "test_utilities.h"
+#include "../attendee_set.h"
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+
+#define NUMBER_TESTS 4
+/** Ids of the tests fall in the first four groups of 2^16 ids */
+#define GROUP_SIZE 65536
+#define MODEL_SIZE (4 * GROUP_SIZE)
+#define ARRAY_MAX_SIZE 4096
+#define ARRAY_MIN_SIZE 2048
+#define BATCH_SIZE 1000
+
+static bool model1[MODEL_SIZE];
+static bool model2[MODEL_SIZE];
+static bool expected[MODEL_SIZE];
+
+/** Checks the size, the contents and both ways of iterating over the set against model */
+static bool matchesModel(AttendeeSet set, const bool *model)
+{
+    int size = 0;
+    for (int id = 0; id < MODEL_SIZE; id++)
+    {
+        size += model[id];
+        if (attendeeSetContains(set, id) != model[id])
+        {
+            return false;
+        }
+    }
+    if (attendeeSetGetSize(set) != size)
+    {
+        return false;
+    }
+
+    int previous = -1;
+    ATTENDEE_SET_FOREACH(id, set)
+    {
+        if (id <= previous || id >= MODEL_SIZE || !model[id])
+        {
+            return false;
+        }
+        previous = id;
+    }
+
+    int ids[BATCH_SIZE];
+    int copied = 0;
+    int last = -1;
+    int count;
+    while ((count = attendeeSetGetNextIds(set, last, ids, BATCH_SIZE)) > 0)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            if (ids[i] <= last || !model[ids[i]])
+            {
+                return false;
+            }
+            last = ids[i];
+        }
+        copied += count;
+    }
+    return count == 0 && copied == size;
+}
+
+static bool addToBoth(AttendeeSet set, bool *model, int id)
+{
+    model[id] = true;
+    return attendeeSetAdd(set, id) == ATTENDEE_SET_SUCCESS;
+}
+
+static bool removeFromBoth(AttendeeSet set, bool *model, int id)
+{
+    model[id] = false;
+    return attendeeSetRemove(set, id) == ATTENDEE_SET_SUCCESS;
+}
+
+static int countModel(const bool *model)
+{
+    int count = 0;
+    for (int id = 0; id < MODEL_SIZE; id++)
+    {
+        count += model[id];
+    }
+    return count;
+}
+
+bool testAttendeeSetBasic()
+{
+    bool result = true;
+    AttendeeSet set = attendeeSetCreate();
+    AttendeeSet copy = NULL;
+    ASSERT_TEST(set != NULL && attendeeSetGetSize(set) == 0, destroyAttendeeSetBasic);
+    ASSERT_TEST(attendeeSetGetFirst(set) == ATTENDEE_SET_NO_ID, destroyAttendeeSetBasic);
+
+    ASSERT_TEST(attendeeSetAdd(set, 5) == ATTENDEE_SET_SUCCESS, destroyAttendeeSetBasic);
+    ASSERT_TEST(attendeeSetAdd(set, 5) == ATTENDEE_SET_ID_ALREADY_EXISTS, destroyAttendeeSetBasic);
+    ASSERT_TEST(attendeeSetAdd(set, -1) == ATTENDEE_SET_INVALID_ID, destroyAttendeeSetBasic);
+    ASSERT_TEST(attendeeSetAdd(set, INT_MAX) == ATTENDEE_SET_SUCCESS, destroyAttendeeSetBasic);
+    ASSERT_TEST(attendeeSetAdd(set, 0) == ATTENDEE_SET_SUCCESS, destroyAttendeeSetBasic);
+    ASSERT_TEST(attendeeSetAdd(NULL, 1) == ATTENDEE_SET_NULL_ARGUMENT, destroyAttendeeSetBasic);
+    ASSERT_TEST(attendeeSetRemove(set, 6) == ATTENDEE_SET_ID_DOES_NOT_EXIST, destroyAttendeeSetBasic);
+    ASSERT_TEST(attendeeSetRemove(NULL, 5) == ATTENDEE_SET_NULL_ARGUMENT, destroyAttendeeSetBasic);
+
+    ASSERT_TEST(attendeeSetGetFirst(set) == 0 && attendeeSetGetNext(set, 0) == 5, destroyAttendeeSetBasic);
+    ASSERT_TEST(attendeeSetGetNext(set, 6) == INT_MAX, destroyAttendeeSetBasic);
+    ASSERT_TEST(attendeeSetGetNext(set, INT_MAX) == ATTENDEE_SET_NO_ID, destroyAttendeeSetBasic);
+
+    copy = attendeeSetCopy(set);
+    ASSERT_TEST(copy != NULL && attendeeSetRemove(set, 5) == ATTENDEE_SET_SUCCESS, destroyAttendeeSetBasic);
+    ASSERT_TEST(attendeeSetContains(copy, 5) && !attendeeSetContains(set, 5), destroyAttendeeSetBasic);
+    ASSERT_TEST(attendeeSetGetSize(copy) == 3 && attendeeSetGetSize(set) == 2, destroyAttendeeSetBasic);
+
+    int ids[2];
+    ASSERT_TEST(attendeeSetGetNextIds(copy, -1, ids, 2) == 2 && ids[0] == 0 && ids[1] == 5, destroyAttendeeSetBasic);
+    ASSERT_TEST(attendeeSetGetNextIds(copy, 5, ids, 2) == 1 && ids[0] == INT_MAX, destroyAttendeeSetBasic);
+    ASSERT_TEST(attendeeSetGetNextIds(copy, INT_MAX, ids, 2) == 0, destroyAttendeeSetBasic);
+    ASSERT_TEST(attendeeSetGetNextIds(NULL, -1, ids, 2) == -1, destroyAttendeeSetBasic);
+    ASSERT_TEST(attendeeSetGetNextIds(copy, -1, ids, -1) == -1, destroyAttendeeSetBasic);
+    ASSERT_TEST(attendeeSetGetSize(NULL) == -1 && attendeeSetGetIntersectionSize(set, NULL) == -1,
+                destroyAttendeeSetBasic);
+    ASSERT_TEST(attendeeSetUnite(NULL, set) == ATTENDEE_SET_NULL_ARGUMENT, destroyAttendeeSetBasic);
+
+destroyAttendeeSetBasic:
+    attendeeSetDestroy(set);
+    attendeeSetDestroy(copy);
+    return result;
+}
+
+/** A group turns into a bitmap past ARRAY_MAX_SIZE ids and back into an array at ARRAY_MIN_SIZE */
+bool testAttendeeSetContainerBoundaries()
+{
+    bool result = true;
+    memset(model1, 0, sizeof(model1));
+    memset(model2, 0, sizeof(model2));
+    AttendeeSet set = attendeeSetCreate();
+    AttendeeSet other = attendeeSetCreate();
+    ASSERT_TEST(set != NULL && other != NULL, destroyAttendeeSetContainerBoundaries);
+
+    // every other id of the second group, so the bitmap is not full
+    int size = 0;
+    for (; size < ARRAY_MAX_SIZE + 100; size++)
+    {
+        ASSERT_TEST(addToBoth(set, model1, GROUP_SIZE + 2 * size), destroyAttendeeSetContainerBoundaries);
+        if (size >= ARRAY_MAX_SIZE - 2 && size <= ARRAY_MAX_SIZE + 1)
+        {
+            ASSERT_TEST(matchesModel(set, model1), destroyAttendeeSetContainerBoundaries);
+        }
+    }
+    // ids are added in the middle of the bitmap and the array as well
+    ASSERT_TEST(addToBoth(set, model1, GROUP_SIZE + 1), destroyAttendeeSetContainerBoundaries);
+    ASSERT_TEST(addToBoth(set, model1, 7), destroyAttendeeSetContainerBoundaries);
+    ASSERT_TEST(matchesModel(set, model1), destroyAttendeeSetContainerBoundaries);
+
+    for (int id = GROUP_SIZE + 2 * size - 2; attendeeSetGetSize(set) > ARRAY_MIN_SIZE - 2; id -= 2)
+    {
+        ASSERT_TEST(removeFromBoth(set, model1, id), destroyAttendeeSetContainerBoundaries);
+        int group_size = attendeeSetGetSize(set) - 1;
+        if (group_size >= ARRAY_MIN_SIZE - 1 && group_size <= ARRAY_MIN_SIZE + 1)
+        {
+            ASSERT_TEST(matchesModel(set, model1), destroyAttendeeSetContainerBoundaries);
+        }
+    }
+    ASSERT_TEST(addToBoth(set, model1, GROUP_SIZE + 3), destroyAttendeeSetContainerBoundaries);
+    ASSERT_TEST(removeFromBoth(set, model1, GROUP_SIZE + 1), destroyAttendeeSetContainerBoundaries);
+    ASSERT_TEST(matchesModel(set, model1), destroyAttendeeSetContainerBoundaries);
+
+    // two arrays uniting past ARRAY_MAX_SIZE, then shrinking back to an array by subtraction
+    for (int i = 0; i < ARRAY_MAX_SIZE - 1000; i++)
+    {
+        ASSERT_TEST(addToBoth(other, model2, GROUP_SIZE + 2 * i + 1), destroyAttendeeSetContainerBoundaries);
+    }
+    ASSERT_TEST(attendeeSetUnite(set, other) == ATTENDEE_SET_SUCCESS, destroyAttendeeSetContainerBoundaries);
+    for (int id = 0; id < MODEL_SIZE; id++)
+    {
+        model1[id] = model1[id] || model2[id];
+    }
+    ASSERT_TEST(attendeeSetGetSize(set) > ARRAY_MAX_SIZE, destroyAttendeeSetContainerBoundaries);
+    ASSERT_TEST(matchesModel(set, model1), destroyAttendeeSetContainerBoundaries);
+    ASSERT_TEST(attendeeSetSubtract(set, other) == ATTENDEE_SET_SUCCESS, destroyAttendeeSetContainerBoundaries);
+    for (int id = 0; id < MODEL_SIZE; id++)
+    {
+        model1[id] = model1[id] && !model2[id];
+    }
+    ASSERT_TEST(attendeeSetGetSize(set) <= ARRAY_MIN_SIZE, destroyAttendeeSetContainerBoundaries);
+    ASSERT_TEST(matchesModel(set, model1), destroyAttendeeSetContainerBoundaries);
+    ASSERT_TEST(addToBoth(set, model1, GROUP_SIZE + 5), destroyAttendeeSetContainerBoundaries);
+    ASSERT_TEST(matchesModel(set, model1), destroyAttendeeSetContainerBoundaries);
+
+destroyAttendeeSetContainerBoundaries:
+    attendeeSetDestroy(set);
+    attendeeSetDestroy(other);
+    return result;
+}
+
+/** Checks the counts and results of combining set1 with set2, whose ids are first and second */
+static bool combinesLikeModels(AttendeeSet set1, const bool *first, AttendeeSet set2, const bool *second)
+{
+    int intersection = 0, union_size = 0, difference = 0;
+    for (int id = 0; id < MODEL_SIZE; id++)
+    {
+        intersection += first[id] && second[id];
+        union_size += first[id] || second[id];
+        difference += first[id] && !second[id];
+    }
+    if (attendeeSetGetIntersectionSize(set1, set2) != intersection ||
+        attendeeSetGetUnionSize(set1, set2) != union_size ||
+        attendeeSetGetDifferenceSize(set1, set2) != difference)
+    {
+        return false;
+    }
+
+    bool matches = true;
+    AttendeeSet result = attendeeSetCopy(set1);
+    matches = matches && attendeeSetIntersect(result, set2) == ATTENDEE_SET_SUCCESS;
+    for (int id = 0; id < MODEL_SIZE; id++)
+    {
+        expected[id] = first[id] && second[id];
+    }
+    matches = matches && matchesModel(result, expected);
+    attendeeSetDestroy(result);
+
+    result = attendeeSetCopy(set1);
+    matches = matches && attendeeSetUnite(result, set2) == ATTENDEE_SET_SUCCESS;
+    for (int id = 0; id < MODEL_SIZE; id++)
+    {
+        expected[id] = first[id] || second[id];
+    }
+    matches = matches && matchesModel(result, expected);
+    attendeeSetDestroy(result);
+
+    result = attendeeSetCopy(set1);
+    matches = matches && attendeeSetSubtract(result, set2) == ATTENDEE_SET_SUCCESS;
+    for (int id = 0; id < MODEL_SIZE; id++)
+    {
+        expected[id] = first[id] && !second[id];
+    }
+    matches = matches && matchesModel(result, expected);
+    attendeeSetDestroy(result);
+    return matches;
+}
+
+/** The groups of the two sets pair a bitmap with an array, an array with a bitmap, two arrays and two bitmaps */
+bool testAttendeeSetMixedContainers()
+{
+    bool result = true;
+    memset(model1, 0, sizeof(model1));
+    memset(model2, 0, sizeof(model2));
+    AttendeeSet set1 = attendeeSetCreate();
+    AttendeeSet set2 = attendeeSetCreate();
+    ASSERT_TEST(set1 != NULL && set2 != NULL, destroyAttendeeSetMixedContainers);
+
+    for (int id = 0; id < 30000; id += 3)
+    {
+        ASSERT_TEST(addToBoth(set1, model1, id), destroyAttendeeSetMixedContainers);
+    }
+    for (int id = 0; id < 20000; id += 7)
+    {
+        ASSERT_TEST(addToBoth(set2, model2, id), destroyAttendeeSetMixedContainers);
+    }
+    for (int id = GROUP_SIZE; id < GROUP_SIZE + 20000; id += 100)
+    {
+        ASSERT_TEST(addToBoth(set1, model1, id), destroyAttendeeSetMixedContainers);
+    }
+    for (int id = GROUP_SIZE; id < GROUP_SIZE + 20000; id += 2)
+    {
+        ASSERT_TEST(addToBoth(set2, model2, id), destroyAttendeeSetMixedContainers);
+    }
+    for (int id = 2 * GROUP_SIZE; id < 2 * GROUP_SIZE + 50000; id += 25)
+    {
+        ASSERT_TEST(addToBoth(set1, model1, id), destroyAttendeeSetMixedContainers);
+    }
+    for (int id = 2 * GROUP_SIZE; id < 2 * GROUP_SIZE + 50000; id += 15)
+    {
+        ASSERT_TEST(addToBoth(set2, model2, id), destroyAttendeeSetMixedContainers);
+    }
+    for (int id = 3 * GROUP_SIZE; id < 3 * GROUP_SIZE + 50000; id += 5)
+    {
+        ASSERT_TEST(addToBoth(set1, model1, id), destroyAttendeeSetMixedContainers);
+        ASSERT_TEST(addToBoth(set2, model2, id + id % 2), destroyAttendeeSetMixedContainers);
+    }
+    ASSERT_TEST(addToBoth(set2, model2, 4 * GROUP_SIZE - 1), destroyAttendeeSetMixedContainers);
+    ASSERT_TEST(matchesModel(set1, model1) && matchesModel(set2, model2), destroyAttendeeSetMixedContainers);
+
+    ASSERT_TEST(combinesLikeModels(set1, model1, set2, model2), destroyAttendeeSetMixedContainers);
+    ASSERT_TEST(combinesLikeModels(set2, model2, set1, model1), destroyAttendeeSetMixedContainers);
+
+    // a bitmap intersected with a sparse array ends up small enough to be an array again
+    for (int id = GROUP_SIZE; id < GROUP_SIZE + 20000; id += 2)
+    {
+        ASSERT_TEST(removeFromBoth(set2, model2, id), destroyAttendeeSetMixedContainers);
+    }
+    ASSERT_TEST(combinesLikeModels(set1, model1, set2, model2), destroyAttendeeSetMixedContainers);
+    ASSERT_TEST(combinesLikeModels(set2, model2, set1, model1), destroyAttendeeSetMixedContainers);
+
+destroyAttendeeSetMixedContainers:
+    attendeeSetDestroy(set1);
+    attendeeSetDestroy(set2);
+    return result;
+}
+
+bool testAttendeeSetSelfOperations()
+{
+    bool result = true;
+    memset(model1, 0, sizeof(model1));
+    AttendeeSet set = attendeeSetCreate();
+    ASSERT_TEST(set != NULL, destroyAttendeeSetSelfOperations);
+    for (int id = 0; id < 10000; id++)
+    {
+        ASSERT_TEST(addToBoth(set, model1, id), destroyAttendeeSetSelfOperations);
+    }
+    for (int id = GROUP_SIZE; id < GROUP_SIZE + 1000; id += 10)
+    {
+        ASSERT_TEST(addToBoth(set, model1, id), destroyAttendeeSetSelfOperations);
+    }
+    int size = countModel(model1);
+
+    ASSERT_TEST(attendeeSetGetIntersectionSize(set, set) == size, destroyAttendeeSetSelfOperations);
+    ASSERT_TEST(attendeeSetGetUnionSize(set, set) == size, destroyAttendeeSetSelfOperations);
+    ASSERT_TEST(attendeeSetGetDifferenceSize(set, set) == 0, destroyAttendeeSetSelfOperations);
+    ASSERT_TEST(attendeeSetUnite(set, set) == ATTENDEE_SET_SUCCESS, destroyAttendeeSetSelfOperations);
+    ASSERT_TEST(matchesModel(set, model1), destroyAttendeeSetSelfOperations);
+    ASSERT_TEST(attendeeSetIntersect(set, set) == ATTENDEE_SET_SUCCESS, destroyAttendeeSetSelfOperations);
+    ASSERT_TEST(matchesModel(set, model1), destroyAttendeeSetSelfOperations);
+    ASSERT_TEST(attendeeSetSubtract(set, set) == ATTENDEE_SET_SUCCESS, destroyAttendeeSetSelfOperations);
+    memset(model1, 0, sizeof(model1));
+    ASSERT_TEST(matchesModel(set, model1), destroyAttendeeSetSelfOperations);
+    ASSERT_TEST(attendeeSetGetFirst(set) == ATTENDEE_SET_NO_ID, destroyAttendeeSetSelfOperations);
+
+    // the emptied set is still usable
+    ASSERT_TEST(addToBoth(set, model1, GROUP_SIZE + 1), destroyAttendeeSetSelfOperations);
+    ASSERT_TEST(matchesModel(set, model1), destroyAttendeeSetSelfOperations);
+
+destroyAttendeeSetSelfOperations:
+    attendeeSetDestroy(set);
+    return result;
+}
+
+bool (*tests[])(void) = {
+    testAttendeeSetBasic,
+    testAttendeeSetContainerBoundaries,
+    testAttendeeSetMixedContainers,
+    testAttendeeSetSelfOperations};
+
+const char *testNames[] = {
+    "testAttendeeSetBasic",
+    "testAttendeeSetContainerBoundaries",
+    "testAttendeeSetMixedContainers",
+    "testAttendeeSetSelfOperations"};
+
+int main(int argc, char *argv[])
+{
+    if (argc == 1)
+    {
+        for (int test_idx = 0; test_idx < NUMBER_TESTS; test_idx++)
+        {
+            RUN_TEST(tests[test_idx], testNames[test_idx]);
+        }
+        return 0;
+    }
+    if (argc != 2)
+    {
+        fprintf(stdout, "Usage: attendee_set_tests <test index>\n");
+        return 0;
+    }
+
+    int test_idx = strtol(argv[1], NULL, 10);
+    if (test_idx < 1 || test_idx > NUMBER_TESTS)
+    {
+        fprintf(stderr, "Invalid test index %d\n", test_idx);
+        return 0;
+    }
+
+    RUN_TEST(tests[test_idx - 1], testNames[test_idx - 1]);
+    return 0;
+}
@@ -0,0 +1,479 @@
+#include "test_utilities.h"
+#include "../date.h"
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+
+#define NUMBER_TESTS 11
+#define MAX_RUNS 8
+#define MANY_SERIALS (4 * 16 + 3)
+
+static bool dateIs(Date date, int day, int month, int year)
+{
+    int date_day, date_month, date_year;
+    return dateGet(date, &date_day, &date_month, &date_year) && date_day == day &&
+           date_month == month && date_year == year;
+}
+
+/** Records the runs passed to it by dateRangeForEach */
+typedef struct DateRuns_t
+{
+    int size;
+    DateValue first[MAX_RUNS];
+    int count[MAX_RUNS];
+} DateRuns;
+
+static void recordRun(DateValue first, int count, void *context)
+{
+    DateRuns *runs = context;
+    if (runs->size < MAX_RUNS)
+    {
+        runs->first[runs->size] = first;
+        runs->count[runs->size] = count;
+    }
+    runs->size++;
+}
+
+static DateValue valueOf(int day, int month, int year)
+{
+    DateValue value;
+    char buf[DATE_FORMAT_BUFFER_SIZE];
+    int length = sprintf(buf, "%d.%d.%d", day, month, year);
+    return dateValueParse(buf, length, &value) ? value : DATE_VALUE_INVALID;
+}
+
+/** Returns the number of days dateRangeNext walks from lo to hi, or -1 if they are out of order */
+static int countRangeDays(DateValue lo, DateValue hi)
+{
+    int count = 0;
+    DateValue previous = lo;
+    DateRange range = dateRangeBegin(lo, hi);
+    for (DateValue day; dateRangeNext(&range, &day);)
+    {
+        if (day != (count == 0 ? lo : previous + 1))
+        {
+            return -1;
+        }
+        previous = day;
+        count++;
+    }
+    return count;
+}
+
+bool testDateAdvance()
+{
+    bool result = true;
+    Date date = dateCreate(30, 12, 2000);
+    ASSERT_TEST(date != NULL, returnDateAdvance);
+
+    dateAdvance(date, 1);
+    ASSERT_TEST(dateIs(date, 1, 1, 2001), destroyDateAdvance);
+    dateAdvance(date, -1);
+    ASSERT_TEST(dateIs(date, 30, 12, 2000), destroyDateAdvance);
+    dateTick(date);
+    ASSERT_TEST(dateIs(date, 1, 1, 2001), destroyDateAdvance);
+    dateAdvance(date, 0);
+    ASSERT_TEST(dateIs(date, 1, 1, 2001), destroyDateAdvance);
+    dateAdvance(date, 3 * DATE_VALUE_DAYS_IN_YEAR + 45);
+    ASSERT_TEST(dateIs(date, 16, 2, 2004), destroyDateAdvance);
+    dateAdvance(date, -(2005 * DATE_VALUE_DAYS_IN_YEAR));
+    ASSERT_TEST(dateIs(date, 16, 2, -1), destroyDateAdvance);
+    dateAdvance(NULL, 1);
+
+destroyDateAdvance:
+    dateDestroy(date);
+returnDateAdvance:
+    return result;
+}
+
+bool testDateDiffDays()
+{
+    bool result = true;
+    Date first = dateCreate(30, 12, 2000);
+    Date second = dateCreate(1, 1, 2001);
+    ASSERT_TEST(first != NULL && second != NULL, destroyDateDiffDays);
+
+    ASSERT_TEST(dateDiffDays(second, first) == 1, destroyDateDiffDays);
+    ASSERT_TEST(dateDiffDays(first, second) == -1, destroyDateDiffDays);
+    ASSERT_TEST(dateDiffDays(first, first) == 0, destroyDateDiffDays);
+    ASSERT_TEST(dateDiffDays(first, NULL) == 0 && dateDiffDays(NULL, first) == 0, destroyDateDiffDays);
+
+    dateAdvance(second, -100);
+    ASSERT_TEST(dateDiffDays(second, first) == -99, destroyDateDiffDays);
+    ASSERT_TEST(dateCompare(second, first) < 0, destroyDateDiffDays);
+    dateAdvance(second, 99);
+    ASSERT_TEST(dateDiffDays(second, first) == 0, destroyDateDiffDays);
+    ASSERT_TEST(dateCompare(second, first) == 0, destroyDateDiffDays);
+
+destroyDateDiffDays:
+    dateDestroy(first);
+    dateDestroy(second);
+    return result;
+}
+
+/** Moving a date by nearly INT_MAX days must not overflow, it stops at the first or last legal date */
+bool testDateAdvanceLargeDays()
+{
+    bool result = true;
+    Date date = dateCreate(1, 1, -5000000);
+    Date start = dateCreate(1, 1, -5000000);
+    ASSERT_TEST(date != NULL && start != NULL, destroyDateAdvanceLargeDays);
+
+    // a legal date more than INT_MAX - 100 days after the start
+    dateAdvance(date, INT_MAX - 100);
+    ASSERT_TEST(dateSerial(date) == dateSerial(start) + (INT_MAX - 100), destroyDateAdvanceLargeDays);
+    ASSERT_TEST(dateDiffDays(date, start) == INT_MAX - 100, destroyDateAdvanceLargeDays);
+    ASSERT_TEST(dateDiffDays(start, date) == -(INT_MAX - 100), destroyDateAdvanceLargeDays);
+
+    dateAdvance(date, INT_MAX);
+    ASSERT_TEST(dateSerial(date) == DATE_VALUE_MAX, destroyDateAdvanceLargeDays);
+    ASSERT_TEST(dateIs(date, 30, 12, DATE_VALUE_MAX_YEAR), destroyDateAdvanceLargeDays);
+    dateTick(date);
+    ASSERT_TEST(dateSerial(date) == DATE_VALUE_MAX, destroyDateAdvanceLargeDays);
+    dateAdvance(date, INT_MAX);
+    ASSERT_TEST(dateSerial(date) == DATE_VALUE_MAX, destroyDateAdvanceLargeDays);
+
+    dateAdvance(start, INT_MIN);
+    ASSERT_TEST(dateSerial(start) == DATE_VALUE_MIN, destroyDateAdvanceLargeDays);
+    ASSERT_TEST(dateIs(start, 1, 1, -DATE_VALUE_MAX_YEAR), destroyDateAdvanceLargeDays);
+    dateAdvance(start, INT_MIN);
+    ASSERT_TEST(dateSerial(start) == DATE_VALUE_MIN, destroyDateAdvanceLargeDays);
+
+    // the first and last legal dates are more than INT_MAX days apart
+    ASSERT_TEST(dateDiffDays(date, start) == INT_MAX, destroyDateAdvanceLargeDays);
+    ASSERT_TEST(dateDiffDays(start, date) == INT_MIN, destroyDateAdvanceLargeDays);
+    ASSERT_TEST(dateCompare(date, start) > 0 && dateCompare(start, date) < 0, destroyDateAdvanceLargeDays);
+
+    ASSERT_TEST(dateValueAddDays(DATE_VALUE_MAX - 1, 1) == DATE_VALUE_MAX, destroyDateAdvanceLargeDays);
+    ASSERT_TEST(dateValueAddDays(DATE_VALUE_MIN + 1, -1) == DATE_VALUE_MIN, destroyDateAdvanceLargeDays);
+    ASSERT_TEST(dateValueAddDays(0, INT_MAX) == DATE_VALUE_MAX, destroyDateAdvanceLargeDays);
+    ASSERT_TEST(dateValueAddDays(0, INT_MIN) == DATE_VALUE_MIN, destroyDateAdvanceLargeDays);
+
+destroyDateAdvanceLargeDays:
+    dateDestroy(date);
+    dateDestroy(start);
+    return result;
+}
+
+bool testDateCreateYearBounds()
+{
+    bool result = true;
+    Date last = dateCreate(30, 12, DATE_VALUE_MAX_YEAR);
+    Date first = dateCreate(1, 1, -DATE_VALUE_MAX_YEAR);
+    ASSERT_TEST(last != NULL && first != NULL, destroyDateCreateYearBounds);
+    ASSERT_TEST(dateIs(last, 30, 12, DATE_VALUE_MAX_YEAR), destroyDateCreateYearBounds);
+    ASSERT_TEST(dateIs(first, 1, 1, -DATE_VALUE_MAX_YEAR), destroyDateCreateYearBounds);
+    ASSERT_TEST(dateSerial(last) > 0 && dateSerial(first) < 0, destroyDateCreateYearBounds);
+    ASSERT_TEST(dateSerial(first) != DATE_VALUE_INVALID, destroyDateCreateYearBounds);
+    ASSERT_TEST(dateCompare(first, last) < 0, destroyDateCreateYearBounds);
+    ASSERT_TEST(dateSerial(NULL) == DATE_VALUE_INVALID, destroyDateCreateYearBounds);
+
+    ASSERT_TEST(dateCreate(1, 1, DATE_VALUE_MAX_YEAR + 1) == NULL, destroyDateCreateYearBounds);
+    ASSERT_TEST(dateCreate(30, 12, -DATE_VALUE_MAX_YEAR - 1) == NULL, destroyDateCreateYearBounds);
+    ASSERT_TEST(dateCreate(1, 1, INT_MAX) == NULL, destroyDateCreateYearBounds);
+    ASSERT_TEST(dateCreate(1, 1, INT_MIN) == NULL, destroyDateCreateYearBounds);
+
+destroyDateCreateYearBounds:
+    dateDestroy(last);
+    dateDestroy(first);
+    return result;
+}
+
+/** Counts the values in [lo, hi] one at a time, the result dateCountInRange must match */
+static int countInRange(const DateValue *serials, int count, DateValue lo, DateValue hi)
+{
+    int in_range = 0;
+    for (int i = 0; i < count; i++)
+    {
+        in_range += serials[i] >= lo && serials[i] <= hi;
+    }
+    return in_range;
+}
+
+/** Tries every count that ends a batch of lanes differently and ranges bounded by stored values */
+bool testDateCountInRange()
+{
+    bool result = true;
+    DateValue serials[MANY_SERIALS];
+    for (int i = 0; i < MANY_SERIALS; i++)
+    {
+        serials[i] = (i * 37) % 101 - 50;
+    }
+    serials[MANY_SERIALS - 1] = DATE_VALUE_MAX;
+    serials[MANY_SERIALS - 2] = DATE_VALUE_MIN;
+    const int counts[] = {0, 1, 3, 4, 5, 8, MANY_SERIALS - 1, MANY_SERIALS};
+    const DateValue ranges[][2] = {{-50, 50}, {-10, -3}, {serials[0], serials[0]}, {serials[2], serials[5]},
+                                   {0, DATE_VALUE_MAX}, {DATE_VALUE_MIN, -1}, {DATE_VALUE_MIN, DATE_VALUE_MAX},
+                                   {INT32_MIN, INT32_MAX}, {51, DATE_VALUE_MAX - 1}};
+
+    for (int i = 0; i < (int)(sizeof(counts) / sizeof(*counts)); i++)
+    {
+        for (int j = 0; j < (int)(sizeof(ranges) / sizeof(*ranges)); j++)
+        {
+            DateValue lo = ranges[j][0];
+            DateValue hi = ranges[j][1];
+            ASSERT_TEST(dateCountInRange(serials, counts[i], lo, hi) == countInRange(serials, counts[i], lo, hi),
+                        returnDateCountInRange);
+            // the same values one lane further, so they do not start at the beginning of a batch
+            if (counts[i] < MANY_SERIALS)
+            {
+                ASSERT_TEST(dateCountInRange(serials + 1, counts[i], lo, hi) ==
+                            countInRange(serials + 1, counts[i], lo, hi), returnDateCountInRange);
+            }
+            int reversed = lo == hi ? countInRange(serials, counts[i], lo, hi) : 0;
+            ASSERT_TEST(dateCountInRange(serials, counts[i], hi, lo) == reversed, returnDateCountInRange);
+        }
+    }
+    ASSERT_TEST(dateCountInRange(serials, MANY_SERIALS, -50, 50) == MANY_SERIALS - 2, returnDateCountInRange);
+    ASSERT_TEST(dateCountInRange(serials, MANY_SERIALS, DATE_VALUE_MAX, DATE_VALUE_MAX) == 1, returnDateCountInRange);
+    ASSERT_TEST(dateCountInRange(NULL, MANY_SERIALS, -50, 50) == 0, returnDateCountInRange);
+    ASSERT_TEST(dateCountInRange(serials, -1, -50, 50) == 0, returnDateCountInRange);
+
+returnDateCountInRange:
+    return result;
+}
+
+bool testDateBucketByMonth()
+{
+    bool result = true;
+    const DateValue serials[] = {valueOf(15, 3, 2000), valueOf(1, 1, -1), valueOf(30, 12, -1), DATE_VALUE_INVALID,
+                                 valueOf(1, 3, -100), valueOf(30, 12, DATE_VALUE_MAX_YEAR),
+                                 valueOf(1, 1, -DATE_VALUE_MAX_YEAR), DATE_VALUE_INVALID, valueOf(30, 6, 0)};
+    const int expected[DATE_VALUE_MONTHS_IN_YEAR] = {2, 0, 2, 0, 0, 1, 0, 0, 0, 0, 0, 2};
+    int buckets[DATE_VALUE_MONTHS_IN_YEAR];
+
+    // the buckets are cleared first
+    memset(buckets, 1, sizeof(buckets));
+    dateBucketByMonth(serials, sizeof(serials) / sizeof(*serials), buckets);
+    ASSERT_TEST(memcmp(buckets, expected, sizeof(buckets)) == 0, returnDateBucketByMonth);
+
+    dateBucketByMonth(serials, 0, buckets);
+    for (int i = 0; i < DATE_VALUE_MONTHS_IN_YEAR; i++)
+    {
+        ASSERT_TEST(buckets[i] == 0, returnDateBucketByMonth);
+    }
+    buckets[0] = 1;
+    dateBucketByMonth(NULL, 1, buckets);
+    dateBucketByMonth(serials, 1, NULL);
+    ASSERT_TEST(buckets[0] == 1, returnDateBucketByMonth);
+
+returnDateBucketByMonth:
+    return result;
+}
+
+bool testDateSerialsFromArray()
+{
+    bool result = true;
+    Date dates[] = {dateCreate(1, 1, 2000), NULL, dateCreate(30, 12, -1), NULL};
+    DateValue serials[] = {0, 0, 0, 0, 1};
+    ASSERT_TEST(dates[0] != NULL && dates[2] != NULL, destroyDateSerialsFromArray);
+
+    dateSerialsFromArray(dates, 4, serials);
+    ASSERT_TEST(serials[0] == valueOf(1, 1, 2000) && serials[1] == DATE_VALUE_INVALID, destroyDateSerialsFromArray);
+    ASSERT_TEST(serials[2] == valueOf(30, 12, -1) && serials[3] == DATE_VALUE_INVALID, destroyDateSerialsFromArray);
+    ASSERT_TEST(serials[4] == 1, destroyDateSerialsFromArray);
+
+    // the NULL dates are skipped by the batch functions
+    int buckets[DATE_VALUE_MONTHS_IN_YEAR];
+    dateBucketByMonth(serials, 4, buckets);
+    ASSERT_TEST(buckets[0] == 1 && buckets[11] == 1, destroyDateSerialsFromArray);
+    ASSERT_TEST(dateCountInRange(serials, 4, DATE_VALUE_MIN, DATE_VALUE_MAX) == 2, destroyDateSerialsFromArray);
+
+    dateSerialsFromArray(NULL, 4, serials);
+    dateSerialsFromArray(dates, 4, NULL);
+    ASSERT_TEST(serials[0] == valueOf(1, 1, 2000), destroyDateSerialsFromArray);
+
+destroyDateSerialsFromArray:
+    dateDestroy(dates[0]);
+    dateDestroy(dates[2]);
+    return result;
+}
+
+/** Parses text, which must be a legal date, and checks that formatting gives it back */
+static bool parsesBack(const char *text)
+{
+    DateValue value;
+    char buf[DATE_FORMAT_BUFFER_SIZE];
+    return dateValueParse(text, strlen(text), &value) && dateValueFormat(value, buf) == (int)strlen(text) &&
+           strcmp(buf, text) == 0;
+}
+
+static bool parseFails(const char *text)
+{
+    DateValue value = 0;
+    return !dateValueParse(text, strlen(text), &value) && value == 0;
+}
+
+bool testDateParseRoundTrip()
+{
+    bool result = true;
+    const char *legal[] = {"1.1.0", "30.12.-1", "15.6.2024", "1.1.-100", "30.12.5965231", "1.1.-5965231"};
+    for (int i = 0; i < (int)(sizeof(legal) / sizeof(*legal)); i++)
+    {
+        ASSERT_TEST(parsesBack(legal[i]), returnDateParseRoundTrip);
+    }
+
+    DateValue values[] = {0, -1, 359, 360, -360, 12345678, -12345678,
+                          DATE_VALUE_MAX_YEAR * DATE_VALUE_DAYS_IN_YEAR + DATE_VALUE_DAYS_IN_YEAR - 1,
+                          -DATE_VALUE_MAX_YEAR * DATE_VALUE_DAYS_IN_YEAR};
+    for (int i = 0; i < (int)(sizeof(values) / sizeof(*values)); i++)
+    {
+        char buf[DATE_FORMAT_BUFFER_SIZE];
+        DateValue parsed;
+        int length = dateValueFormat(values[i], buf);
+        ASSERT_TEST(dateValueParse(buf, length, &parsed) && parsed == values[i], returnDateParseRoundTrip);
+    }
+
+    Date date = NULL;
+    char buf[DATE_FORMAT_BUFFER_SIZE];
+    // the length bounds the text, so a date followed by more characters parses
+    ASSERT_TEST(dateParse("7.8.1999 and more", 8, &date), returnDateParseRoundTrip);
+    ASSERT_TEST(dateIs(date, 7, 8, 1999), destroyDateParseRoundTrip);
+    ASSERT_TEST(dateFormat(date, buf) == 8 && strcmp(buf, "7.8.1999") == 0, destroyDateParseRoundTrip);
+
+destroyDateParseRoundTrip:
+    dateDestroy(date);
+returnDateParseRoundTrip:
+    return result;
+}
+
+bool testDateParseIllegal()
+{
+    bool result = true;
+    const char *illegal[] = {
+        // bad separators
+        "1/1/2000", "1..1.2000", "1.1-2000", "1.1.2000.", ".1.1.2000", "1.1.+2000", "1.1.--2000", " 1.1.2000",
+        // empty fields
+        "", ".", "..", ".1.2000", "1..2000", "1.1.", "1.1.-",
+        // day and month out of range
+        "0.1.2000", "31.1.2000", "1.0.2000", "1.13.2000", "-1.1.2000",
+        // years beyond DATE_VALUE_MAX_YEAR and numbers too long to parse
+        "1.1.5965232", "1.1.-5965232", "1.1.999999999", "1.1.-999999999", "1.1.1234567890",
+        "0000000001.1.2000"};
+    for (int i = 0; i < (int)(sizeof(illegal) / sizeof(*illegal)); i++)
+    {
+        ASSERT_TEST(parseFails(illegal[i]), returnDateParseIllegal);
+    }
+
+    DateValue value;
+    Date date = NULL;
+    ASSERT_TEST(!dateValueParse(NULL, 0, &value) && !dateValueParse("1.1.1", 5, NULL), returnDateParseIllegal);
+    ASSERT_TEST(!dateParse("1.1.1", 5, NULL) && !dateParse("31.1.1", 6, &date) && date == NULL,
+                returnDateParseIllegal);
+
+returnDateParseIllegal:
+    return result;
+}
+
+bool testDateRangeNext()
+{
+    bool result = true;
+    DateValue day = valueOf(15, 6, 2024);
+    DateValue year_end = valueOf(28, 12, 2024);
+    DateValue next_year = valueOf(3, 1, 2025);
+
+    ASSERT_TEST(countRangeDays(day, day) == 1, returnDateRangeNext);
+    ASSERT_TEST(countRangeDays(day, day - 1) == 0, returnDateRangeNext);
+    ASSERT_TEST(countRangeDays(next_year, year_end) == 0, returnDateRangeNext);
+    ASSERT_TEST(countRangeDays(year_end, next_year) == 6, returnDateRangeNext);
+    ASSERT_TEST(countRangeDays(INT32_MAX - 2, INT32_MAX) == 3, returnDateRangeNext);
+
+    DateRange range = dateRangeBegin(year_end, next_year);
+    DateValue value = 0;
+    for (int i = 0; i < 3; i++)
+    {
+        ASSERT_TEST(dateRangeNext(&range, &value), returnDateRangeNext);
+    }
+    ASSERT_TEST(value == valueOf(30, 12, 2024), returnDateRangeNext);
+    ASSERT_TEST(dateRangeNext(&range, &value) && value == valueOf(1, 1, 2025), returnDateRangeNext);
+
+    range = dateRangeBegin(day, day);
+    ASSERT_TEST(dateRangeNext(&range, &value) && value == day, returnDateRangeNext);
+    ASSERT_TEST(!dateRangeNext(&range, &value) && !dateRangeNext(&range, &value), returnDateRangeNext);
+
+returnDateRangeNext:
+    return result;
+}
+
+bool testDateRangeForEach()
+{
+    bool result = true;
+    DateValue day = valueOf(15, 6, 2024);
+    DateRuns runs = {0};
+
+    dateRangeForEach(day, day, recordRun, &runs);
+    ASSERT_TEST(runs.size == 1 && runs.first[0] == day && runs.count[0] == 1, returnDateRangeForEach);
+
+    runs.size = 0;
+    dateRangeForEach(day, day - 1, recordRun, &runs);
+    ASSERT_TEST(runs.size == 0, returnDateRangeForEach);
+    dateRangeForEach(day, day, NULL, &runs);
+
+    // 28.11.2024 to 2.1.2025 is three days of November, all of December and two days of January
+    dateRangeForEach(valueOf(28, 11, 2024), valueOf(2, 1, 2025), recordRun, &runs);
+    ASSERT_TEST(runs.size == 3, returnDateRangeForEach);
+    ASSERT_TEST(runs.first[0] == valueOf(28, 11, 2024) && runs.count[0] == 3, returnDateRangeForEach);
+    ASSERT_TEST(runs.first[1] == valueOf(1, 12, 2024) && runs.count[1] == 30, returnDateRangeForEach);
+    ASSERT_TEST(runs.first[2] == valueOf(1, 1, 2025) && runs.count[2] == 2, returnDateRangeForEach);
+
+    runs.size = 0;
+    dateRangeForEach(valueOf(30, 12, -1), valueOf(1, 1, 0), recordRun, &runs);
+    ASSERT_TEST(runs.size == 2 && runs.count[0] == 1 && runs.first[1] == 0 && runs.count[1] == 1,
+                returnDateRangeForEach);
+
+returnDateRangeForEach:
+    return result;
+}
+
+bool (*tests[])(void) = {
+    testDateAdvance,
+    testDateDiffDays,
+    testDateAdvanceLargeDays,
+    testDateCreateYearBounds,
+    testDateParseRoundTrip,
+    testDateParseIllegal,
+    testDateRangeNext,
+    testDateRangeForEach,
+    testDateCountInRange,
+    testDateBucketByMonth,
+    testDateSerialsFromArray};
+
+const char *testNames[] = {
+    "testDateAdvance",
+    "testDateDiffDays",
+    "testDateAdvanceLargeDays",
+    "testDateCreateYearBounds",
+    "testDateParseRoundTrip",
+    "testDateParseIllegal",
+    "testDateRangeNext",
+    "testDateRangeForEach",
+    "testDateCountInRange",
+    "testDateBucketByMonth",
+    "testDateSerialsFromArray"};
+
+int main(int argc, char *argv[])
+{
+    if (argc == 1)
+    {
+        for (int test_idx = 0; test_idx < NUMBER_TESTS; test_idx++)
+        {
+            RUN_TEST(tests[test_idx], testNames[test_idx]);
+        }
+        return 0;
+    }
+    if (argc != 2)
+    {
+        fprintf(stdout, "Usage: date_tests <test index>\n");
+        return 0;
+    }
+
+    int test_idx = strtol(argv[1], NULL, 10);
+    if (test_idx < 1 || test_idx > NUMBER_TESTS)
+    {
+        fprintf(stderr, "Invalid test index %d\n", test_idx);
+        return 0;
+    }
+
+    RUN_TEST(tests[test_idx - 1], testNames[test_idx - 1]);
+    return 0;
+}
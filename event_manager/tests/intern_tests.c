@@ -0,0 +1,214 @@
+#include "test_utilities.h"
+#include "../intern.h"
+#include "../event.h"
+#include "../member.h"
+#include "../event_manager.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define NUMBER_TESTS 5
+#define MANY_STRINGS 1000
+#define NAME_SIZE 16
+
+/** The hit rate counts every internString call of the process, so this test must run first */
+bool testInternHitRate()
+{
+    bool result = true;
+    ASSERT_TEST(internGetHitRate() == 0, returnInternHitRate);
+
+    char *first = internString("hit");
+    ASSERT_TEST(first != NULL && internGetHitRate() == 0, releaseFirstInternHitRate);
+    char *second = internString("hit");
+    ASSERT_TEST(second == first && internGetHitRate() == 0.5, releaseSecondInternHitRate);
+    char *third = internString("miss");
+    ASSERT_TEST(third != NULL && internGetHitRate() == 1.0 / 3, releaseThirdInternHitRate);
+    // neither a failed call nor a lookup that does not intern counts
+    ASSERT_TEST(internString(NULL) == NULL && internFind("hit") == first, releaseThirdInternHitRate);
+    ASSERT_TEST(internGetHitRate() == 1.0 / 3, releaseThirdInternHitRate);
+
+releaseThirdInternHitRate:
+    internRelease(third);
+releaseSecondInternHitRate:
+    internRelease(second);
+releaseFirstInternHitRate:
+    internRelease(first);
+returnInternHitRate:
+    return result;
+}
+
+bool testInternSharesStrings()
+{
+    bool result = true;
+    int size = internGetSize();
+    char text[] = "alpha";
+    char *alpha = internString(text);
+    char *again = internString("alpha");
+    char *beta = internString("beta");
+    ASSERT_TEST(alpha != NULL && again != NULL && beta != NULL, releaseInternSharesStrings);
+    ASSERT_TEST(alpha == again && alpha != text && alpha != beta, releaseInternSharesStrings);
+    ASSERT_TEST(strcmp(alpha, "alpha") == 0 && strcmp(beta, "beta") == 0, releaseInternSharesStrings);
+    ASSERT_TEST(internGetSize() == size + 2, releaseInternSharesStrings);
+    ASSERT_TEST(internFind("alpha") == alpha && internFind("gamma") == NULL, releaseInternSharesStrings);
+    ASSERT_TEST(internGetHash(alpha) != 0 && internGetHash(alpha) == internGetHash(again), releaseInternSharesStrings);
+    ASSERT_TEST(internGetHash(NULL) == 0, releaseInternSharesStrings);
+
+releaseInternSharesStrings:
+    internRelease(alpha);
+    internRelease(again);
+    internRelease(beta);
+    ASSERT_TEST(internGetSize() == size, returnInternSharesStrings);
+returnInternSharesStrings:
+    return result;
+}
+
+bool testInternReleaseOnLastReference()
+{
+    bool result = true;
+    int size = internGetSize();
+    char *name = internString("counted");
+    ASSERT_TEST(name != NULL, returnInternReleaseOnLastReference);
+    ASSERT_TEST(internRetain(name) == name && internRetain(name) == name, returnInternReleaseOnLastReference);
+    ASSERT_TEST(internRetain(NULL) == NULL, returnInternReleaseOnLastReference);
+    internRelease(NULL);
+
+    internRelease(name);
+    internRelease(name);
+    ASSERT_TEST(internFind("counted") == name && internGetSize() == size + 1, returnInternReleaseOnLastReference);
+    internRelease(name);
+    ASSERT_TEST(internFind("counted") == NULL && internGetSize() == size, returnInternReleaseOnLastReference);
+
+    // the table frees its slots when it becomes empty and must be usable again afterwards
+    name = internString("counted");
+    ASSERT_TEST(name != NULL && internFind("counted") == name, returnInternReleaseOnLastReference);
+    internRelease(name);
+    ASSERT_TEST(internFind("counted") == NULL, returnInternReleaseOnLastReference);
+
+returnInternReleaseOnLastReference:
+    return result;
+}
+
+bool testInternManyStrings()
+{
+    bool result = true;
+    int size = internGetSize();
+    char *strings[MANY_STRINGS] = {NULL};
+    char name[NAME_SIZE];
+    for (int i = 0; i < MANY_STRINGS; i++)
+    {
+        sprintf(name, "name%d", i);
+        strings[i] = internString(name);
+        ASSERT_TEST(strings[i] != NULL, releaseInternManyStrings);
+    }
+    ASSERT_TEST(internGetSize() == size + MANY_STRINGS, releaseInternManyStrings);
+
+    // removing every other string shifts entries back over the holes they leave
+    for (int i = 0; i < MANY_STRINGS; i += 2)
+    {
+        internRelease(strings[i]);
+        strings[i] = NULL;
+    }
+    for (int i = 0; i < MANY_STRINGS; i++)
+    {
+        sprintf(name, "name%d", i);
+        ASSERT_TEST(internFind(name) == strings[i], releaseInternManyStrings);
+    }
+
+releaseInternManyStrings:
+    for (int i = 0; i < MANY_STRINGS; i++)
+    {
+        internRelease(strings[i]);
+    }
+    ASSERT_TEST(internGetSize() == size, returnInternManyStrings);
+returnInternManyStrings:
+    return result;
+}
+
+/** Members and events share their interned names, the last one destroyed releases them */
+bool testInternNamesOfMembersAndEvents()
+{
+    bool result = true;
+    Member member = memberCreate(1, "shared");
+    Member member_copy = memberCopy(member);
+    Event event = eventCreate(1, "shared", 0);
+    Event event_copy = eventCopy(event);
+    EventManager em = NULL;
+    Date date = dateCreate(1, 1, 2000);
+    ASSERT_TEST(member != NULL && event != NULL && event_copy != NULL, destroyInternNamesOfMembersAndEvents);
+    ASSERT_TEST(internGetSize() == 1, destroyInternNamesOfMembersAndEvents);
+    ASSERT_TEST(memberGetName(member) == eventGetName(event), destroyInternNamesOfMembersAndEvents);
+    ASSERT_TEST(eventGetName(event_copy) == eventGetName(event), destroyInternNamesOfMembersAndEvents);
+
+    memberDestroy(member);
+    memberDestroy(member_copy);
+    member = member_copy = NULL;
+    eventDestroy(event);
+    event = NULL;
+    ASSERT_TEST(internFind("shared") == eventGetName(event_copy), destroyInternNamesOfMembersAndEvents);
+    eventDestroy(event_copy);
+    event_copy = NULL;
+    ASSERT_TEST(internFind("shared") == NULL && internGetSize() == 0, destroyInternNamesOfMembersAndEvents);
+
+    em = createEventManager(date);
+    ASSERT_TEST(em != NULL, destroyInternNamesOfMembersAndEvents);
+    ASSERT_TEST(emAddMember(em, "shared", 1) == EM_SUCCESS, destroyInternNamesOfMembersAndEvents);
+    ASSERT_TEST(emAddMember(em, "shared", 2) == EM_SUCCESS, destroyInternNamesOfMembersAndEvents);
+    ASSERT_TEST(emAddEventByDiff(em, "shared", 1, 1) == EM_SUCCESS, destroyInternNamesOfMembersAndEvents);
+    ASSERT_TEST(emAddMemberToEvent(em, 1, 1) == EM_SUCCESS, destroyInternNamesOfMembersAndEvents);
+    ASSERT_TEST(internGetSize() == 1, destroyInternNamesOfMembersAndEvents);
+    ASSERT_TEST(emRemoveMember(em, 1) == EM_SUCCESS && emRemoveEvent(em, 1) == EM_SUCCESS,
+                destroyInternNamesOfMembersAndEvents);
+    ASSERT_TEST(internFind("shared") != NULL, destroyInternNamesOfMembersAndEvents);
+    destroyEventManager(em);
+    em = NULL;
+    ASSERT_TEST(internFind("shared") == NULL && internGetSize() == 0, destroyInternNamesOfMembersAndEvents);
+
+destroyInternNamesOfMembersAndEvents:
+    destroyEventManager(em);
+    dateDestroy(date);
+    memberDestroy(member);
+    memberDestroy(member_copy);
+    eventDestroy(event);
+    eventDestroy(event_copy);
+    return result;
+}
+
+bool (*tests[])(void) = {
+    testInternHitRate,
+    testInternSharesStrings,
+    testInternReleaseOnLastReference,
+    testInternManyStrings,
+    testInternNamesOfMembersAndEvents};
+
+const char *testNames[] = {
+    "testInternHitRate",
+    "testInternSharesStrings",
+    "testInternReleaseOnLastReference",
+    "testInternManyStrings",
+    "testInternNamesOfMembersAndEvents"};
+
+int main(int argc, char *argv[])
+{
+    if (argc == 1)
+    {
+        for (int test_idx = 0; test_idx < NUMBER_TESTS; test_idx++)
+        {
+            RUN_TEST(tests[test_idx], testNames[test_idx]);
+        }
+        return 0;
+    }
+    if (argc != 2)
+    {
+        fprintf(stdout, "Usage: intern_tests <test index>\n");
+        return 0;
+    }
+
+    int test_idx = strtol(argv[1], NULL, 10);
+    if (test_idx < 1 || test_idx > NUMBER_TESTS)
+    {
+        fprintf(stderr, "Invalid test index %d\n", test_idx);
+        return 0;
+    }
+
+    RUN_TEST(tests[test_idx - 1], testNames[test_idx - 1]);
+    return 0;
+}
@@ -1,8 +1,10 @@
 #include "test_utilities.h"
 #include "../priority_queue.h"
 #include <stdlib.h>
+#include <string.h>
 
-#define NUMBER_TESTS 4
+#define NUMBER_TESTS 11
+#define KEY_RANGE 100
 
 static PQElementPriority copyIntGeneric(PQElementPriority n)
 {
@@ -34,6 +36,95 @@ static bool equalIntsGeneric(PQElementPriority n1, PQElementPriority n2)
     return *(int *)n1 == *(int *)n2;
 }
 
+/** Elements equal by their last two digits, so equal elements can still differ */
+static bool equalLastDigitsGeneric(PQElement n1, PQElement n2)
+{
+    return *(int *)n1 % KEY_RANGE == *(int *)n2 % KEY_RANGE;
+}
+
+static size_t encodeIntGeneric(PQElement n, void *buffer, size_t buffer_size)
+{
+    if (buffer_size >= sizeof(int))
+    {
+        memcpy(buffer, n, sizeof(int));
+    }
+    return sizeof(int);
+}
+
+static PQElement decodeIntGeneric(const void *buffer, size_t size)
+{
+    if (size != sizeof(int))
+    {
+        return NULL;
+    }
+    int *n = malloc(sizeof(*n));
+    if (!n)
+    {
+        return NULL;
+    }
+    memcpy(n, buffer, sizeof(*n));
+    return n;
+}
+
+static void storeIntByIndex(PQElement element, PQElementPriority priority, int index, void *context)
+{
+    ((int *)context)[index] = *(int *)element;
+}
+
+static bool intHasKeyGeneric(PQElement n, const void *key)
+{
+    return *(int *)n == *(const int *)key;
+}
+
+static unsigned int hashIntKey(const void *key)
+{
+    return (unsigned int)*(const int *)key % 7;
+}
+
+static unsigned int hashIntElement(PQElement n)
+{
+    return hashIntKey(n);
+}
+
+static bool isPriorityBelowGeneric(PQElement n, PQElementPriority priority, void *bound)
+{
+    return *(int *)priority < *(int *)bound;
+}
+
+/** Returns the position of the stored element in the queue, or -1 */
+static int positionInQueue(PriorityQueue pq, PQElement element)
+{
+    int position = 0;
+    PQ_FOREACH_ENTRY(entry, pq)
+    {
+        if (entry.element == element)
+        {
+            return position;
+        }
+        position++;
+    }
+    return -1;
+}
+
+/** Checks that two queues hold equal elements with equal priorities in the same order */
+static bool sameEntries(PriorityQueue pq1, PriorityQueue pq2)
+{
+    if (pqGetSize(pq1) != pqGetSize(pq2))
+    {
+        return false;
+    }
+    PQEntry entry2 = pqGetFirstEntry(pq2);
+    PQ_FOREACH_ENTRY(entry1, pq1)
+    {
+        if (*(int *)entry1.element != *(int *)entry2.element || *(int *)entry1.priority != *(int *)entry2.priority)
+        {
+            return false;
+        }
+        entry2 = pqGetNextEntry(pq2);
+    }
+    return true;
+}
+
 bool testPQCreateDestroy()
 {
     bool result = true;
@@ -110,17 +201,300 @@ destroyPQIterator:
     return result;
 }
 
+bool testPQCopyPastInlineBuffer()
+{
+    bool result = true;
+    PriorityQueue pq = pqCreate(copyIntGeneric, freeIntGeneric, equalIntsGeneric, copyIntGeneric, freeIntGeneric, compareIntsGeneric);
+    PriorityQueue copy = NULL;
+
+    int max_value = 100;
+
+    for (int i = 0; i < max_value; i++)
+    {
+        ASSERT_TEST(pqInsert(pq, &i, &i) == PQ_SUCCESS, destroyPQCopyPastInlineBuffer);
+    }
+
+    copy = pqCopy(pq);
+    ASSERT_TEST(copy != NULL, destroyPQCopyPastInlineBuffer);
+    ASSERT_TEST(pqGetSize(copy) == max_value, destroyPQCopyPastInlineBuffer);
+
+    int expected = max_value - 1;
+    PQ_FOREACH(int *, iter, copy)
+    {
+        ASSERT_TEST(*iter == expected, destroyPQCopyPastInlineBuffer);
+        expected--;
+    }
+    ASSERT_TEST(expected == -1, destroyPQCopyPastInlineBuffer);
+
+destroyPQCopyPastInlineBuffer:
+    pqDestroy(copy);
+    pqDestroy(pq);
+    return result;
+}
+
+bool testPQSerializeDeserialize()
+{
+    bool result = true;
+    const char *file_name = "pq_serialize_test.bin";
+    PriorityQueue pq = pqCreate(copyIntGeneric, freeIntGeneric, equalIntsGeneric, copyIntGeneric, freeIntGeneric, compareIntsGeneric);
+    PriorityQueue loaded = pqCreate(copyIntGeneric, freeIntGeneric, equalIntsGeneric, copyIntGeneric, freeIntGeneric, compareIntsGeneric);
+
+    int max_value = 50;
+    for (int i = 0; i < max_value; i++)
+    {
+        int priority = i % 5;
+        ASSERT_TEST(pqInsert(pq, &i, &priority) == PQ_SUCCESS, destroyPQSerializeDeserialize);
+    }
+
+    ASSERT_TEST(pqSerialize(pq, file_name, encodeIntGeneric, encodeIntGeneric) == PQ_SUCCESS,
+                destroyPQSerializeDeserialize);
+    ASSERT_TEST(pqDeserialize(loaded, file_name, decodeIntGeneric, decodeIntGeneric) == PQ_SUCCESS,
+                destroyPQSerializeDeserialize);
+    ASSERT_TEST(pqGetSize(loaded) == max_value, destroyPQSerializeDeserialize);
+    ASSERT_TEST(pqDeserialize(loaded, file_name, decodeIntGeneric, decodeIntGeneric) == PQ_ERROR,
+                destroyPQSerializeDeserialize);
+
+    while (pqGetSize(pq) > 0)
+    {
+        int *expected = pqGetFirst(pq);
+        int *actual = pqGetFirst(loaded);
+        ASSERT_TEST(actual != NULL && *actual == *expected, destroyPQSerializeDeserialize);
+        pqRemove(pq);
+        pqRemove(loaded);
+    }
+
+destroyPQSerializeDeserialize:
+    remove(file_name);
+    pqDestroy(loaded);
+    pqDestroy(pq);
+    return result;
+}
+
+bool testPQForEachAndParallelForEach()
+{
+    bool result = true;
+    PriorityQueue pq = pqCreate(copyIntGeneric, freeIntGeneric, equalIntsGeneric, copyIntGeneric, freeIntGeneric, compareIntsGeneric);
+    int max_value = 20000;
+    int *visited = calloc(max_value, sizeof(*visited));
+    ASSERT_TEST(visited != NULL, destroyPQForEachAndParallelForEach);
+
+    for (int i = 0; i < max_value; i++)
+    {
+        ASSERT_TEST(pqInsert(pq, &i, &i) == PQ_SUCCESS, destroyPQForEachAndParallelForEach);
+    }
+
+    ASSERT_TEST(pqForEach(pq, storeIntByIndex, visited) == PQ_SUCCESS, destroyPQForEachAndParallelForEach);
+    for (int i = 0; i < max_value; i++)
+    {
+        ASSERT_TEST(visited[i] == max_value - 1 - i, destroyPQForEachAndParallelForEach);
+        visited[i] = -1;
+    }
+
+    ASSERT_TEST(pqParallelForEach(pq, storeIntByIndex, visited, 4) == PQ_SUCCESS, destroyPQForEachAndParallelForEach);
+    for (int i = 0; i < max_value; i++)
+    {
+        ASSERT_TEST(visited[i] == max_value - 1 - i, destroyPQForEachAndParallelForEach);
+    }
+
+destroyPQForEachAndParallelForEach:
+    free(visited);
+    pqDestroy(pq);
+    return result;
+}
+
+bool testPQFindByAndRemoveBy()
+{
+    bool result = true;
+    PriorityQueue pq = pqCreate(copyIntGeneric, freeIntGeneric, equalIntsGeneric, copyIntGeneric, freeIntGeneric, compareIntsGeneric);
+    PriorityQueue copy = NULL;
+    int max_value = 100;
+
+    for (int i = 0; i < max_value; i++)
+    {
+        ASSERT_TEST(pqInsert(pq, &i, &i) == PQ_SUCCESS, destroyPQFindByAndRemoveBy);
+    }
+    int key = 42;
+    ASSERT_TEST(*(int *)pqFindBy(pq, &key, intHasKeyGeneric) == key, destroyPQFindByAndRemoveBy);
+
+    // colliding hashes exercise the probing and the removal from the index
+    ASSERT_TEST(pqSetKeyIndex(pq, hashIntElement, hashIntKey) == PQ_SUCCESS, destroyPQFindByAndRemoveBy);
+    for (int i = 0; i < max_value; i += 3)
+    {
+        ASSERT_TEST(pqRemoveBy(pq, &i, intHasKeyGeneric) == PQ_SUCCESS, destroyPQFindByAndRemoveBy);
+        ASSERT_TEST(pqRemoveBy(pq, &i, intHasKeyGeneric) == PQ_ELEMENT_DOES_NOT_EXISTS, destroyPQFindByAndRemoveBy);
+    }
+    copy = pqCopy(pq);
+    ASSERT_TEST(copy != NULL, destroyPQFindByAndRemoveBy);
+    for (int i = 0; i < max_value; i++)
+    {
+        int *found = pqFindBy(copy, &i, intHasKeyGeneric);
+        ASSERT_TEST((i % 3 == 0) == (found == NULL), destroyPQFindByAndRemoveBy);
+        ASSERT_TEST(found == NULL || *found == i, destroyPQFindByAndRemoveBy);
+    }
+
+destroyPQFindByAndRemoveBy:
+    pqDestroy(copy);
+    pqDestroy(pq);
+    return result;
+}
+
+bool testPQRemoveIf()
+{
+    bool result = true;
+    PriorityQueue pq = pqCreate(copyIntGeneric, freeIntGeneric, equalIntsGeneric, copyIntGeneric, freeIntGeneric, compareIntsGeneric);
+    int max_value = 30;
+
+    for (int i = 0; i < max_value; i++)
+    {
+        int priority = i % 10;
+        ASSERT_TEST(pqInsert(pq, &i, &priority) == PQ_SUCCESS, destroyPQRemoveIf);
+    }
+    int bound = 4;
+    ASSERT_TEST(pqRemoveIf(pq, isPriorityBelowGeneric, &bound) == 12, destroyPQRemoveIf);
+    ASSERT_TEST(pqGetSize(pq) == max_value - 12, destroyPQRemoveIf);
+
+    int previous_priority = 10;
+    int previous_element = -1;
+    PQ_FOREACH_ENTRY(entry, pq)
+    {
+        int priority = *(int *)entry.priority;
+        ASSERT_TEST(priority >= bound && priority <= previous_priority, destroyPQRemoveIf);
+        // equal priorities keep their insertion order
+        ASSERT_TEST(priority < previous_priority || *(int *)entry.element > previous_element, destroyPQRemoveIf);
+        previous_priority = priority;
+        previous_element = *(int *)entry.element;
+    }
+
+destroyPQRemoveIf:
+    pqDestroy(pq);
+    return result;
+}
+
+/** With equal elements, the key index must find the same one as a scan of the queue */
+bool testPQKeyIndexWithEqualKeys()
+{
+    bool result = true;
+    PriorityQueue indexed = pqCreate(copyIntGeneric, freeIntGeneric, equalIntsGeneric, copyIntGeneric, freeIntGeneric, compareIntsGeneric);
+    PriorityQueue scanned = pqCreate(copyIntGeneric, freeIntGeneric, equalIntsGeneric, copyIntGeneric, freeIntGeneric, compareIntsGeneric);
+    ASSERT_TEST(pqSetKeyIndex(indexed, hashIntElement, hashIntKey) == PQ_SUCCESS, destroyPQKeyIndexWithEqualKeys);
+    int max_value = 30;
+
+    // every value is inserted three times with different priorities, some of them equal
+    for (int round = 0; round < 3; round++)
+    {
+        for (int i = 0; i < max_value; i++)
+        {
+            int priority = (i * 7 + round * 11) % 17;
+            ASSERT_TEST(pqInsert(indexed, &i, &priority) == PQ_SUCCESS, destroyPQKeyIndexWithEqualKeys);
+            ASSERT_TEST(pqInsert(scanned, &i, &priority) == PQ_SUCCESS, destroyPQKeyIndexWithEqualKeys);
+        }
+    }
+    for (int i = 0; i < max_value; i++)
+    {
+        int found_at = positionInQueue(indexed, pqFindBy(indexed, &i, intHasKeyGeneric));
+        ASSERT_TEST(found_at >= 0, destroyPQKeyIndexWithEqualKeys);
+        ASSERT_TEST(found_at == positionInQueue(scanned, pqFindBy(scanned, &i, intHasKeyGeneric)),
+                    destroyPQKeyIndexWithEqualKeys);
+    }
+    for (int round = 0; round < 2; round++)
+    {
+        for (int i = round; i < max_value; i += 2)
+        {
+            if (i % 3 == 0)
+            {
+                ASSERT_TEST(pqRemoveElement(indexed, &i) == PQ_SUCCESS, destroyPQKeyIndexWithEqualKeys);
+                ASSERT_TEST(pqRemoveElement(scanned, &i) == PQ_SUCCESS, destroyPQKeyIndexWithEqualKeys);
+            }
+            else
+            {
+                ASSERT_TEST(pqRemoveBy(indexed, &i, intHasKeyGeneric) == PQ_SUCCESS, destroyPQKeyIndexWithEqualKeys);
+                ASSERT_TEST(pqRemoveBy(scanned, &i, intHasKeyGeneric) == PQ_SUCCESS, destroyPQKeyIndexWithEqualKeys);
+            }
+            ASSERT_TEST(sameEntries(indexed, scanned), destroyPQKeyIndexWithEqualKeys);
+        }
+    }
+    for (int i = 0; i < max_value; i++)
+    {
+        ASSERT_TEST(pqContains(indexed, &i), destroyPQKeyIndexWithEqualKeys);
+    }
+
+destroyPQKeyIndexWithEqualKeys:
+    pqDestroy(indexed);
+    pqDestroy(scanned);
+    return result;
+}
+
+/** pqChangePriority stores a copy of the given element, pqMoveElement keeps the stored one */
+bool testPQChangePriorityAndMoveElement()
+{
+    bool result = true;
+    PriorityQueue pq = pqCreate(copyIntGeneric, freeIntGeneric, equalLastDigitsGeneric, copyIntGeneric, freeIntGeneric, compareIntsGeneric);
+    ASSERT_TEST(pqSetKeyIndex(pq, hashIntElement, hashIntKey) == PQ_SUCCESS, destroyPQChangePriorityAndMoveElement);
+    int values[] = {5, 7, 9};
+    int priorities[] = {1, 2, 3};
+    for (int i = 0; i < 3; i++)
+    {
+        ASSERT_TEST(pqInsert(pq, &values[i], &priorities[i]) == PQ_SUCCESS, destroyPQChangePriorityAndMoveElement);
+    }
+
+    // 105 equals the stored 5 and replaces it with its new priority
+    int updated = 105;
+    int high = 10;
+    ASSERT_TEST(pqChangePriority(pq, &updated, &priorities[0], &high) == PQ_SUCCESS,
+                destroyPQChangePriorityAndMoveElement);
+    PQEntry first = pqGetFirstEntry(pq);
+    ASSERT_TEST(*(int *)first.element == 105 && *(int *)first.priority == 10, destroyPQChangePriorityAndMoveElement);
+    ASSERT_TEST(first.element != &updated, destroyPQChangePriorityAndMoveElement);
+    ASSERT_TEST(pqFindBy(pq, &updated, intHasKeyGeneric) == first.element, destroyPQChangePriorityAndMoveElement);
+    ASSERT_TEST(pqFindBy(pq, &values[0], intHasKeyGeneric) == NULL, destroyPQChangePriorityAndMoveElement);
+    ASSERT_TEST(pqGetSize(pq) == 3, destroyPQChangePriorityAndMoveElement);
+
+    // 205 only finds the stored 105, which is moved to its new place as it is
+    int other = 205;
+    int low = 0;
+    PQElement stored = first.element;
+    ASSERT_TEST(pqMoveElement(pq, &other, &high, &low) == PQ_SUCCESS, destroyPQChangePriorityAndMoveElement);
+    ASSERT_TEST(positionInQueue(pq, stored) == 2 && *(int *)stored == 105, destroyPQChangePriorityAndMoveElement);
+    ASSERT_TEST(pqFindBy(pq, &updated, intHasKeyGeneric) == stored, destroyPQChangePriorityAndMoveElement);
+    ASSERT_TEST(*(int *)pqGetFirst(pq) == 9, destroyPQChangePriorityAndMoveElement);
+
+    ASSERT_TEST(pqMoveElement(pq, &other, &high, &low) == PQ_ELEMENT_DOES_NOT_EXISTS,
+                destroyPQChangePriorityAndMoveElement);
+    ASSERT_TEST(pqChangePriority(pq, &other, &high, &low) == PQ_ELEMENT_DOES_NOT_EXISTS,
+                destroyPQChangePriorityAndMoveElement);
+    ASSERT_TEST(pqMoveElement(pq, NULL, &low, &high) == PQ_NULL_ARGUMENT, destroyPQChangePriorityAndMoveElement);
+    ASSERT_TEST(pqMoveElement(NULL, &other, &low, &high) == PQ_NULL_ARGUMENT, destroyPQChangePriorityAndMoveElement);
+
+destroyPQChangePriorityAndMoveElement:
+    pqDestroy(pq);
+    return result;
+}
+
 bool (*tests[])(void) = {
     testPQCreateDestroy,
     testPQInsertAndSize,
     testPQGetFirst,
-    testPQIterator};
+    testPQIterator,
+    testPQCopyPastInlineBuffer,
+    testPQSerializeDeserialize,
+    testPQForEachAndParallelForEach,
+    testPQFindByAndRemoveBy,
+    testPQRemoveIf,
+    testPQKeyIndexWithEqualKeys,
+    testPQChangePriorityAndMoveElement};
 
 const char *testNames[] = {
     "testPQCreateDestroy",
     "testPQInsertAndSize",
     "testPQGetFirst",
-    "testPQIterator"};
+    "testPQIterator",
+    "testPQCopyPastInlineBuffer",
+    "testPQSerializeDeserialize",
+    "testPQForEachAndParallelForEach",
+    "testPQFindByAndRemoveBy",
+    "testPQRemoveIf",
+    "testPQKeyIndexWithEqualKeys",
+    "testPQChangePriorityAndMoveElement"};
 
 int main(int argc, char *argv[])
 {
@@ -0,0 +1,227 @@
+#include "test_utilities.h"
+#include "../priority_queue.h"
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef PQ_STATS
+#error "pq_stats_tests needs the priority queue built with PQ_STATS"
+#endif
+
+#define NUMBER_TESTS 3
+#define INLINE_ENTRIES 8
+
+static PQElementPriority copyIntGeneric(PQElementPriority n)
+{
+    if (!n)
+    {
+        return NULL;
+    }
+    int *copy = malloc(sizeof(*copy));
+    if (!copy)
+    {
+        return NULL;
+    }
+    *copy = *(int *)n;
+    return copy;
+}
+
+static void freeIntGeneric(PQElementPriority n)
+{
+    free(n);
+}
+
+static int compareIntsGeneric(PQElementPriority n1, PQElementPriority n2)
+{
+    return (*(int *)n1 - *(int *)n2);
+}
+
+static bool equalIntsGeneric(PQElementPriority n1, PQElementPriority n2)
+{
+    return *(int *)n1 == *(int *)n2;
+}
+
+static PriorityQueue createIntQueue()
+{
+    return pqCreate(copyIntGeneric, freeIntGeneric, equalIntsGeneric, copyIntGeneric, freeIntGeneric,
+                    compareIntsGeneric);
+}
+
+/** Checks every counter of the queue against the expected ones */
+static bool statsAre(PriorityQueue pq, PQStats expected)
+{
+    PQStats stats;
+    return pqGetStats(pq, &stats) == PQ_SUCCESS && stats.compare_priority == expected.compare_priority &&
+           stats.equal_elements == expected.equal_elements && stats.copy_element == expected.copy_element &&
+           stats.free_element == expected.free_element && stats.copy_priority == expected.copy_priority &&
+           stats.free_priority == expected.free_priority && stats.equal_key == expected.equal_key &&
+           stats.hash == expected.hash && stats.moves == expected.moves && stats.expands == expected.expands &&
+           stats.peak_size == expected.peak_size;
+}
+
+/** Returns counters that are all zero, for the tests to set the ones they expect */
+static PQStats noStats()
+{
+    PQStats stats;
+    memset(&stats, 0, sizeof(stats));
+    return stats;
+}
+
+bool testPQStatsInsertPastInlineBuffer()
+{
+    bool result = true;
+    PriorityQueue pq = createIntQueue();
+    ASSERT_TEST(pq != NULL, returnPQStatsInsertPastInlineBuffer);
+    ASSERT_TEST(statsAre(pq, noStats()), destroyPQStatsInsertPastInlineBuffer);
+
+    // element i gets priority 8 - i, so every element goes to the end without moving the others
+    for (int i = 0; i <= INLINE_ENTRIES; i++)
+    {
+        int priority = INLINE_ENTRIES - i;
+        ASSERT_TEST(pqInsert(pq, &i, &priority) == PQ_SUCCESS, destroyPQStatsInsertPastInlineBuffer);
+    }
+    PQStats expected = noStats();
+    expected.copy_element = INLINE_ENTRIES + 1;
+    expected.copy_priority = INLINE_ENTRIES + 1;
+    // the binary searches over 0 to 8 entries compare 0, 1, 1, 2, 2, 2, 2, 3 and 3 times
+    expected.compare_priority = 16;
+    // only the ninth insert does not fit in the inline buffer
+    expected.expands = 1;
+    expected.peak_size = INLINE_ENTRIES + 1;
+    ASSERT_TEST(statsAre(pq, expected), destroyPQStatsInsertPastInlineBuffer);
+
+    // a new highest priority shifts all nine entries
+    int element = 100;
+    int priority = 100;
+    ASSERT_TEST(pqInsert(pq, &element, &priority) == PQ_SUCCESS, destroyPQStatsInsertPastInlineBuffer);
+    expected.copy_element++;
+    expected.copy_priority++;
+    expected.compare_priority += 4;
+    expected.moves += INLINE_ENTRIES + 1;
+    expected.peak_size++;
+    ASSERT_TEST(statsAre(pq, expected), destroyPQStatsInsertPastInlineBuffer);
+
+destroyPQStatsInsertPastInlineBuffer:
+    pqDestroy(pq);
+returnPQStatsInsertPastInlineBuffer:
+    return result;
+}
+
+bool testPQStatsRemove()
+{
+    bool result = true;
+    PriorityQueue pq = createIntQueue();
+    ASSERT_TEST(pq != NULL, returnPQStatsRemove);
+    for (int i = 0; i <= INLINE_ENTRIES; i++)
+    {
+        int priority = INLINE_ENTRIES - i;
+        ASSERT_TEST(pqInsert(pq, &i, &priority) == PQ_SUCCESS, destroyPQStatsRemove);
+    }
+    ASSERT_TEST(pqResetStats(pq) == PQ_SUCCESS, destroyPQStatsRemove);
+    PQStats expected = noStats();
+    expected.peak_size = INLINE_ENTRIES + 1;
+    ASSERT_TEST(statsAre(pq, expected), destroyPQStatsRemove);
+
+    // removing the first entry shifts the 8 and then the 7 entries after it
+    ASSERT_TEST(pqRemove(pq) == PQ_SUCCESS && pqRemove(pq) == PQ_SUCCESS, destroyPQStatsRemove);
+    expected.free_element = 2;
+    expected.free_priority = 2;
+    expected.moves = 15;
+    ASSERT_TEST(statsAre(pq, expected), destroyPQStatsRemove);
+
+    // 4 is the third of 2 to 8, found after 3 comparisons, and the 4 entries after it shift
+    int element = 4;
+    ASSERT_TEST(pqRemoveElement(pq, &element) == PQ_SUCCESS, destroyPQStatsRemove);
+    expected.free_element++;
+    expected.free_priority++;
+    expected.equal_elements = 3;
+    expected.moves += 4;
+    ASSERT_TEST(statsAre(pq, expected), destroyPQStatsRemove);
+
+    ASSERT_TEST(pqRemoveElement(pq, &element) == PQ_ELEMENT_DOES_NOT_EXISTS, destroyPQStatsRemove);
+    expected.equal_elements += pqGetSize(pq);
+    ASSERT_TEST(statsAre(pq, expected), destroyPQStatsRemove);
+
+    // clearing the queue frees the 6 entries left without shifting them
+    ASSERT_TEST(pqClear(pq) == PQ_SUCCESS, destroyPQStatsRemove);
+    expected.free_element += 6;
+    expected.free_priority += 6;
+    ASSERT_TEST(statsAre(pq, expected), destroyPQStatsRemove);
+
+destroyPQStatsRemove:
+    pqDestroy(pq);
+returnPQStatsRemove:
+    return result;
+}
+
+bool testPQResetStats()
+{
+    bool result = true;
+    PriorityQueue pq = createIntQueue();
+    PQStats stats;
+    ASSERT_TEST(pq != NULL, returnPQResetStats);
+    for (int i = 0; i < INLINE_ENTRIES * 2; i++)
+    {
+        ASSERT_TEST(pqInsert(pq, &i, &i) == PQ_SUCCESS, destroyPQResetStats);
+    }
+    ASSERT_TEST(pqRemove(pq) == PQ_SUCCESS, destroyPQResetStats);
+    ASSERT_TEST(pqGetStats(pq, &stats) == PQ_SUCCESS && stats.expands == 1, destroyPQResetStats);
+    ASSERT_TEST(stats.peak_size == INLINE_ENTRIES * 2 && stats.moves > 0, destroyPQResetStats);
+
+    // every counter is zeroed and the peak restarts from the current size
+    ASSERT_TEST(pqResetStats(pq) == PQ_SUCCESS, destroyPQResetStats);
+    PQStats expected = noStats();
+    expected.peak_size = INLINE_ENTRIES * 2 - 1;
+    ASSERT_TEST(statsAre(pq, expected), destroyPQResetStats);
+
+    // the array keeps its capacity, so refilling it does not expand it again
+    int element = -1;
+    ASSERT_TEST(pqInsert(pq, &element, &element) == PQ_SUCCESS, destroyPQResetStats);
+    ASSERT_TEST(pqGetStats(pq, &stats) == PQ_SUCCESS && stats.expands == 0, destroyPQResetStats);
+    ASSERT_TEST(stats.peak_size == INLINE_ENTRIES * 2, destroyPQResetStats);
+
+    ASSERT_TEST(pqGetStats(NULL, &stats) == PQ_NULL_ARGUMENT, destroyPQResetStats);
+    ASSERT_TEST(pqGetStats(pq, NULL) == PQ_NULL_ARGUMENT, destroyPQResetStats);
+    ASSERT_TEST(pqResetStats(NULL) == PQ_NULL_ARGUMENT, destroyPQResetStats);
+
+destroyPQResetStats:
+    pqDestroy(pq);
+returnPQResetStats:
+    return result;
+}
+
+bool (*tests[])(void) = {
+    testPQStatsInsertPastInlineBuffer,
+    testPQStatsRemove,
+    testPQResetStats};
+
+const char *testNames[] = {
+    "testPQStatsInsertPastInlineBuffer",
+    "testPQStatsRemove",
+    "testPQResetStats"};
+
+int main(int argc, char *argv[])
+{
+    if (argc == 1)
+    {
+        for (int test_idx = 0; test_idx < NUMBER_TESTS; test_idx++)
+        {
+            RUN_TEST(tests[test_idx], testNames[test_idx]);
+        }
+        return 0;
+    }
+    if (argc != 2)
+    {
+        fprintf(stdout, "Usage: pq_stats_tests <test index>\n");
+        return 0;
+    }
+
+    int test_idx = strtol(argv[1], NULL, 10);
+    if (test_idx < 1 || test_idx > NUMBER_TESTS)
+    {
+        fprintf(stderr, "Invalid test index %d\n", test_idx);
+        return 0;
+    }
+
+    RUN_TEST(tests[test_idx - 1], testNames[test_idx - 1]);
+    return 0;
+}